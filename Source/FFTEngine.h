@@ -0,0 +1,613 @@
+/*
+  ==============================================================================
+
+    FFT dla analizatora i przyszłych trybów przetwarzania w dziedzinie częstotliwości:
+    własna FFT (zespolona, sygnału rzeczywistego i dwóch kanałów naraz) oraz współdzielone plany z oknami.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define FFT_ENGINE_USE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+ #include <arm_neon.h>
+ #define FFT_ENGINE_USE_NEON 1
+#endif
+
+enum FFTOrder
+{
+    order512 = 9,
+    order1024 = 10,
+    order2048 = 11,
+    order4096 = 12,
+    order8192 = 13,
+    order16384 = 14,
+    order32768 = 15
+};
+
+//dostęp do pamięci dla motylków - ten sam kod dla pojedynczej próbki i rejestru SIMD
+template<typename T>
+struct FFTLanes;
+
+template<>
+struct FFTLanes<float>
+{
+    static constexpr int width = 1;
+    static float load(const float* p) { return *p; }
+    static void store(float* p, float v) { *p = v; }
+    static float expand(float v) { return v; }
+};
+
+template<>
+struct FFTLanes<juce::dsp::SIMDRegister<float>>
+{
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int width = (int)Vec::SIMDNumElements;
+    static Vec load(const float* p) { return Vec::fromRawArray(p); }
+    static void store(float* p, Vec v) { v.copyToRawArray(p); }
+    static Vec expand(float v) { return Vec::expand(v); }
+};
+
+//zespolona FFT w przód w układzie Stockhama (bez odwracania bitów) z motylkami radix-4 (i radix-2
+//dla parzystości liczby etapów), re/im w osobnych tablicach - kolejne q to kolejne elementy rejestru SIMD
+//wynik wraca do tablic wejściowych, tablice robocze podaje wywołujący - metody są const
+//i jeden obiekt może być używany przez wiele wątków naraz
+struct ComplexFFT
+{
+    explicit ComplexFFT(int order) :
+        size(1 << order)
+    {
+        jassert(order >= 3);
+
+        //parzysta liczba etapów - wynik w tablicach wejściowych
+        auto numRadix4 = order / 2;
+        auto numRadix2 = order % 2;
+        if ((numRadix4 + numRadix2) % 2 != 0)
+        {
+            --numRadix4;
+            numRadix2 += 2;
+        }
+
+        auto n = size;
+        auto stride = 1;
+        auto addStage = [this, &n, &stride](int radix)
+        {
+            stages.push_back({ radix, n, stride, twiddles.size() });
+            for (int p = 0; p < n / radix; ++p)
+            {
+                for (int k = 1; k < radix; ++k)
+                {
+                    const auto angle = -2.0 * juce::MathConstants<double>::pi * k * p / n;
+                    twiddles.push_back((float)std::cos(angle));
+                    twiddles.push_back((float)std::sin(angle));
+                }
+            }
+            n /= radix;
+            stride *= radix;
+        };
+
+        for (int i = 0; i < numRadix4; ++i)
+            addStage(4);
+        for (int i = 0; i < numRadix2; ++i)
+            addStage(2);
+    }
+
+    int getSize() const { return size; }
+
+    void perform(float* re, float* im, float* scratchRe, float* scratchIm) const
+    {
+        using Vec = juce::dsp::SIMDRegister<float>;
+        const auto simd = Vec::isSIMDAligned(re) && Vec::isSIMDAligned(im)
+            && Vec::isSIMDAligned(scratchRe) && Vec::isSIMDAligned(scratchIm);
+
+        float* x[2] = { re, im };
+        float* y[2] = { scratchRe, scratchIm };
+        for (const auto& stage : stages)
+        {
+            if (simd && stage.stride >= FFTLanes<Vec>::width)
+                processStage<Vec>(stage, x[0], x[1], y[0], y[1]);
+            else
+                processStage<float>(stage, x[0], x[1], y[0], y[1]);
+
+            std::swap(x[0], y[0]);
+            std::swap(x[1], y[1]);
+        }
+        jassert(x[0] == re);
+    }
+private:
+    struct Stage
+    {
+        int radix, n, stride;
+        size_t twiddleOffset;
+    };
+
+    template<typename V>
+    void processStage(const Stage& stage, const float* xr, const float* xi, float* yr, float* yi) const
+    {
+        using L = FFTLanes<V>;
+        const auto s = stage.stride;
+        const auto* tw = twiddles.data() + stage.twiddleOffset;
+
+        if (stage.radix == 4)
+        {
+            const auto n1 = stage.n / 4;
+            for (int p = 0; p < n1; ++p, tw += 6)
+            {
+                const auto w1r = L::expand(tw[0]), w1i = L::expand(tw[1]);
+                const auto w2r = L::expand(tw[2]), w2i = L::expand(tw[3]);
+                const auto w3r = L::expand(tw[4]), w3i = L::expand(tw[5]);
+
+                for (int q = 0; q < s; q += L::width)
+                {
+                    const auto i0 = q + s * p, i1 = i0 + s * n1, i2 = i1 + s * n1, i3 = i2 + s * n1;
+                    const auto ar = L::load(xr + i0), ai = L::load(xi + i0);
+                    const auto br = L::load(xr + i1), bi = L::load(xi + i1);
+                    const auto cr = L::load(xr + i2), ci = L::load(xi + i2);
+                    const auto dr = L::load(xr + i3), di = L::load(xi + i3);
+
+                    const auto apcR = ar + cr, apcI = ai + ci;
+                    const auto amcR = ar - cr, amcI = ai - ci;
+                    const auto bpdR = br + dr, bpdI = bi + di;
+                    const auto bmdR = br - dr, bmdI = bi - di;
+
+                    //(a - c) -/+ i (b - d)
+                    const auto t1R = amcR + bmdI, t1I = amcI - bmdR;
+                    const auto t2R = apcR - bpdR, t2I = apcI - bpdI;
+                    const auto t3R = amcR - bmdI, t3I = amcI + bmdR;
+
+                    const auto o = q + s * 4 * p;
+                    L::store(yr + o, apcR + bpdR);
+                    L::store(yi + o, apcI + bpdI);
+                    L::store(yr + o + s, t1R * w1r - t1I * w1i);
+                    L::store(yi + o + s, t1R * w1i + t1I * w1r);
+                    L::store(yr + o + 2 * s, t2R * w2r - t2I * w2i);
+                    L::store(yi + o + 2 * s, t2R * w2i + t2I * w2r);
+                    L::store(yr + o + 3 * s, t3R * w3r - t3I * w3i);
+                    L::store(yi + o + 3 * s, t3R * w3i + t3I * w3r);
+                }
+            }
+        }
+        else
+        {
+            const auto n1 = stage.n / 2;
+            for (int p = 0; p < n1; ++p, tw += 2)
+            {
+                const auto wr = L::expand(tw[0]), wi = L::expand(tw[1]);
+
+                for (int q = 0; q < s; q += L::width)
+                {
+                    const auto i0 = q + s * p, i1 = i0 + s * n1;
+                    const auto ar = L::load(xr + i0), ai = L::load(xi + i0);
+                    const auto br = L::load(xr + i1), bi = L::load(xi + i1);
+                    const auto tR = ar - br, tI = ai - bi;
+
+                    const auto o = q + s * 2 * p;
+                    L::store(yr + o, ar + br);
+                    L::store(yi + o, ai + bi);
+                    L::store(yr + o + s, tR * wr - tI * wi);
+                    L::store(yi + o + s, tR * wi + tI * wr);
+                }
+            }
+        }
+    }
+
+    int size;
+    std::vector<Stage> stages;
+    std::vector<float> twiddles;
+};
+
+//FFT sygnału rzeczywistego: N próbek liczone jako zespolona FFT rozmiaru N/2 (próbki parzyste jako
+//część rzeczywista, nieparzyste jako urojona), widmo rozdzielane z symetrii sprzężonej
+//bufor jak w juce::dsp::FFT (2N floatów), druga połowa służy jako pamięć robocza
+struct RealFFT
+{
+    explicit RealFFT(int order) :
+        size(1 << order),
+        half(size / 2),
+        complexFFT(order - 1)
+    {
+        for (int k = 0; k <= half / 2; ++k)
+        {
+            const auto angle = 2.0 * juce::MathConstants<double>::pi * k / size;
+            postTwiddles.push_back((float)std::cos(angle));
+            postTwiddles.push_back((float)std::sin(angle));
+        }
+    }
+
+    int getSize() const { return size; }
+
+    //wynik jak w juce::dsp::FFT: size / 2 + 1 (lub size) par re/im
+    void performRealOnlyForwardTransform(float* data, bool onlyCalculateNonNegativeFrequencies = false) const
+    {
+        auto* re = data + size;
+        auto* im = re + half;
+        for (int i = 0; i < half; ++i)
+        {
+            re[i] = data[2 * i];
+            im[i] = data[2 * i + 1];
+        }
+
+        //druga połowa bufora na dane, pierwsza (wejście już przepisane) jako robocza
+        complexFFT.perform(re, im, data, data + half);
+
+        //X[k] = (Z[k] + Z*[M-k]) / 2 + e^(-2 pi i k / N) (Z[k] - Z*[M-k]) / 2i, parami k i M-k
+        for (int k = 1; k <= half / 2; ++k)
+        {
+            const auto m = half - k;
+            const auto evenRe = 0.5f * (re[k] + re[m]);
+            const auto evenIm = 0.5f * (im[k] - im[m]);
+            const auto oddRe = 0.5f * (im[k] + im[m]);
+            const auto oddIm = -0.5f * (re[k] - re[m]);
+            const auto c = postTwiddles[(size_t)(2 * k)];
+            const auto s = postTwiddles[(size_t)(2 * k + 1)];
+
+            //w = c - i s dla k, -(c + i s) dla M-k (i sprzężone E, O)
+            data[2 * k] = evenRe + c * oddRe + s * oddIm;
+            data[2 * k + 1] = evenIm + c * oddIm - s * oddRe;
+            data[2 * m] = evenRe - c * oddRe - s * oddIm;
+            data[2 * m + 1] = -evenIm + c * oddIm - s * oddRe;
+        }
+
+        const auto dc = re[0] + im[0];
+        const auto nyquist = re[0] - im[0];
+        data[0] = dc;
+        data[1] = 0.f;
+        data[size] = nyquist;
+        data[size + 1] = 0.f;
+
+        if (!onlyCalculateNonNegativeFrequencies)
+        {
+            for (int k = 1; k < half; ++k)
+            {
+                data[2 * (size - k)] = data[2 * k];
+                data[2 * (size - k) + 1] = -data[2 * k + 1];
+            }
+        }
+    }
+private:
+    int size, half;
+    ComplexFFT complexFFT;
+    std::vector<float> postTwiddles;
+};
+
+
+//moc widma -> dB w jednym przebiegu SIMD: 10 log10(moc * powerScale), przycięte od dołu do floorDb
+//log2 z bitów floata: wykładnik + wielomian 3. stopnia na mantysie (błąd < 0,003 dB);
+//inf, NaN i wartości ujemne dają floorDb
+struct FastDecibels
+{
+    static void powerToDecibels(float* data, int numValues, float powerScale, float floorDb) noexcept
+    {
+        jassert(powerScale > 0.f);
+        const auto offsetDb = 10.f * std::log10(powerScale);
+        int i = 0;
+
+       #if FFT_ENGINE_USE_SSE2
+        const auto expMask = _mm_set1_epi32(0x7F800000), mantissaMask = _mm_set1_epi32(0x007FFFFF);
+        const auto oneBits = _mm_set1_epi32(0x3F800000), bias = _mm_set1_epi32(127);
+        const auto one = _mm_set1_ps(1.f), floor = _mm_set1_ps(floorDb), offset = _mm_set1_ps(offsetDb);
+        const auto k1 = _mm_set1_ps(c1), k2 = _mm_set1_ps(c2), k3 = _mm_set1_ps(c3), dbPerOctaveV = _mm_set1_ps(dbPerOctave);
+
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const auto bits = _mm_castps_si128(_mm_loadu_ps(data + i));
+            const auto expBits = _mm_and_si128(bits, expMask);
+            const auto invalid = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(expBits, expMask), _mm_srai_epi32(bits, 31)));
+
+            const auto exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(expBits, 23), bias));
+            const auto t = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, mantissaMask), oneBits)), one);
+            const auto mantissaLog2 = _mm_mul_ps(t, _mm_add_ps(k1, _mm_mul_ps(t, _mm_add_ps(k2, _mm_mul_ps(t, k3)))));
+
+            auto db = _mm_add_ps(_mm_mul_ps(_mm_add_ps(exponent, mantissaLog2), dbPerOctaveV), offset);
+            db = _mm_max_ps(db, floor);
+            db = _mm_or_ps(_mm_and_ps(invalid, floor), _mm_andnot_ps(invalid, db));
+            _mm_storeu_ps(data + i, db);
+        }
+       #elif FFT_ENGINE_USE_NEON
+        const auto expMask = vdupq_n_u32(0x7F800000), mantissaMask = vdupq_n_u32(0x007FFFFF);
+        const auto oneBits = vdupq_n_u32(0x3F800000), signBit = vdupq_n_u32(0x80000000);
+        const auto floor = vdupq_n_f32(floorDb), offset = vdupq_n_f32(offsetDb);
+
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const auto bits = vreinterpretq_u32_f32(vld1q_f32(data + i));
+            const auto expBits = vandq_u32(bits, expMask);
+            const auto invalid = vorrq_u32(vceqq_u32(expBits, expMask), vcgeq_u32(bits, signBit));
+
+            const auto exponent = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(expBits, 23)), vdupq_n_s32(127)));
+            const auto t = vsubq_f32(vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, mantissaMask), oneBits)), vdupq_n_f32(1.f));
+            const auto mantissaLog2 = vmulq_f32(t, vaddq_f32(vdupq_n_f32(c1), vmulq_f32(t, vaddq_f32(vdupq_n_f32(c2), vmulq_f32(t, vdupq_n_f32(c3))))));
+
+            auto db = vaddq_f32(vmulq_f32(vaddq_f32(exponent, mantissaLog2), vdupq_n_f32(dbPerOctave)), offset);
+            db = vmaxq_f32(db, floor);
+            vst1q_f32(data + i, vbslq_f32(invalid, floor, db));
+        }
+       #endif
+
+        for (; i < numValues; ++i)
+            data[i] = powerToDecibels(data[i], offsetDb, floorDb);
+    }
+
+    //średni poziom w dB wartości podanych w dB, uśredniany w mocy (nie w dB - to byłaby średnia geometryczna,
+    //zaniżona przy pojedynczych prążkach); 2^x z bitów floata: wykładnik + wielomian 3. stopnia (błąd < 0,001 dB)
+    static float powerMeanDecibels(const float* decibels, int numValues, float floorDb) noexcept
+    {
+        jassert(numValues > 0);
+        auto sum = 0.f;
+        int i = 0;
+
+       #if FFT_ENGINE_USE_SSE2
+        const auto toOctaves = _mm_set1_ps(1.f / dbPerOctave);
+        const auto minOctaves = _mm_set1_ps(minExponent), maxOctaves = _mm_set1_ps(maxExponent);
+        const auto one = _mm_set1_ps(1.f);
+        const auto bias = _mm_set1_epi32(127);
+        const auto k1 = _mm_set1_ps(e1), k2 = _mm_set1_ps(e2), k3 = _mm_set1_ps(e3);
+        auto acc = _mm_setzero_ps();
+
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const auto x = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(decibels + i), toOctaves), maxOctaves), minOctaves);
+
+            //podłoga: obcięcie do zera, -1 tam, gdzie obcięcie poszło w górę (x < 0)
+            auto exponent = _mm_cvttps_epi32(x);
+            exponent = _mm_add_epi32(exponent, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(exponent), x)));
+
+            const auto t = _mm_sub_ps(x, _mm_cvtepi32_ps(exponent));
+            const auto mantissa = _mm_add_ps(one, _mm_mul_ps(t, _mm_add_ps(k1, _mm_mul_ps(t, _mm_add_ps(k2, _mm_mul_ps(t, k3))))));
+            const auto scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, bias), 23));
+            acc = _mm_add_ps(acc, _mm_mul_ps(mantissa, scale));
+        }
+
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, acc);
+        sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+       #elif FFT_ENGINE_USE_NEON
+        const auto toOctaves = vdupq_n_f32(1.f / dbPerOctave);
+        const auto minOctaves = vdupq_n_f32(minExponent), maxOctaves = vdupq_n_f32(maxExponent);
+        auto acc = vdupq_n_f32(0.f);
+
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const auto x = vmaxq_f32(vminq_f32(vmulq_f32(vld1q_f32(decibels + i), toOctaves), maxOctaves), minOctaves);
+
+            auto exponent = vcvtq_s32_f32(x);
+            exponent = vaddq_s32(exponent, vreinterpretq_s32_u32(vcgtq_f32(vcvtq_f32_s32(exponent), x)));
+
+            const auto t = vsubq_f32(x, vcvtq_f32_s32(exponent));
+            const auto mantissa = vaddq_f32(vdupq_n_f32(1.f), vmulq_f32(t, vaddq_f32(vdupq_n_f32(e1), vmulq_f32(t, vaddq_f32(vdupq_n_f32(e2), vmulq_f32(t, vdupq_n_f32(e3)))))));
+            const auto scale = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(exponent, vdupq_n_s32(127)), 23));
+            acc = vaddq_f32(acc, vmulq_f32(mantissa, scale));
+        }
+
+        float lanes[4];
+        vst1q_f32(lanes, acc);
+        sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+       #endif
+
+        for (; i < numValues; ++i)
+            sum += decibelsToPower(decibels[i]);
+
+        return powerToDecibels(sum / (float)numValues, 0.f, floorDb);
+    }
+private:
+    //log2(1 + t) ~ t (c1 + t (c2 + t c3)), t w [0, 1)
+    static constexpr float c1 = 1.42461049f, c2 = -0.58928329f, c3 = 0.16545401f;
+    static constexpr float dbPerOctave = 3.01029996f; //10 log10(2)
+
+    //2^t ~ 1 + t (e1 + t (e2 + t e3)), t w [0, 1); wykładnik ograniczony do liczb znormalizowanych
+    static constexpr float e1 = 0.69550201f, e2 = 0.22626982f, e3 = 0.07822817f;
+    static constexpr float minExponent = -126.f, maxExponent = 127.f;
+
+    static float decibelsToPower(float db) noexcept
+    {
+        const auto x = juce::jlimit(minExponent, maxExponent, db / dbPerOctave);
+        const auto exponent = std::floor(x);
+        const auto t = x - exponent;
+        const auto scaleBits = (uint32_t)((int)exponent + 127) << 23;
+        float scale;
+        std::memcpy(&scale, &scaleBits, sizeof(scale));
+
+        return (1.f + t * (e1 + t * (e2 + t * e3))) * scale;
+    }
+
+    static float powerToDecibels(float power, float offsetDb, float floorDb) noexcept
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &power, sizeof(bits));
+        if ((bits & 0x7F800000u) == 0x7F800000u || (bits & 0x80000000u) != 0)
+            return floorDb;
+
+        const auto exponent = static_cast<float>((int)(bits >> 23) - 127);
+        const auto mantissaBits = (bits & 0x007FFFFFu) | 0x3F800000u;
+        float mantissa;
+        std::memcpy(&mantissa, &mantissaBits, sizeof(mantissa));
+        const auto t = mantissa - 1.f;
+
+        return juce::jmax(floorDb, (exponent + t * (c1 + t * (c2 + t * c3))) * dbPerOctave + offsetDb);
+    }
+};
+
+//balistyka widma w dB dla kolumn wyświetlacza w jednym przebiegu SIMD:
+//average = level + averaging * (average - level), peak = max(level, peak - peakDecayDb)
+struct SpectrumBallistics
+{
+    static void process(const float* levels, float* average, float* peak, int numValues,
+                        float averaging, float peakDecayDb) noexcept
+    {
+        int i = 0;
+
+       #if FFT_ENGINE_USE_SSE2
+        const auto a = _mm_set1_ps(averaging), decay = _mm_set1_ps(peakDecayDb);
+
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const auto level = _mm_loadu_ps(levels + i);
+            const auto avg = _mm_loadu_ps(average + i);
+            _mm_storeu_ps(average + i, _mm_add_ps(level, _mm_mul_ps(a, _mm_sub_ps(avg, level))));
+            _mm_storeu_ps(peak + i, _mm_max_ps(level, _mm_sub_ps(_mm_loadu_ps(peak + i), decay)));
+        }
+       #elif FFT_ENGINE_USE_NEON
+        const auto a = vdupq_n_f32(averaging), decay = vdupq_n_f32(peakDecayDb);
+
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const auto level = vld1q_f32(levels + i);
+            const auto avg = vld1q_f32(average + i);
+            vst1q_f32(average + i, vmlaq_f32(level, a, vsubq_f32(avg, level)));
+            vst1q_f32(peak + i, vmaxq_f32(level, vsubq_f32(vld1q_f32(peak + i), decay)));
+        }
+       #endif
+
+        for (; i < numValues; ++i)
+        {
+            average[i] = levels[i] + averaging * (average[i] - levels[i]);
+            peak[i] = juce::jmax(levels[i], peak[i] - peakDecayDb);
+        }
+    }
+};
+
+//silnik FFT dla planu: JUCE (vDSP/IPP/MKL/FFTW, jeśli są) albo własne RealFFT i ComplexFFT
+enum class FFTEngine
+{
+    juceFFT,
+    inTree
+};
+
+//bez biblioteki platformowej juce::dsp::FFT liczy zespoloną FFT pełnego rozmiaru - wtedy własna
+#if JUCE_MAC || JUCE_IOS || JUCE_IPP_AVAILABLE || JUCE_DSP_USE_INTEL_MKL || JUCE_DSP_USE_SHARED_FFTW || JUCE_DSP_USE_STATIC_FFTW
+static constexpr FFTEngine defaultFFTEngine = FFTEngine::juceFFT;
+#else
+static constexpr FFTEngine defaultFFTEngine = FFTEngine::inTree;
+#endif
+
+//plan FFT dla jednego rzędu (okna osobno - FFTPlanCache::getWindow)
+//plan własny (inTree) jest niezmienny i może być używany przez wiele wątków naraz (pamięć robocza od wywołującego);
+//juce::dsp::FFT nie gwarantuje współbieżnego perform() (np. IPP ma bufor roboczy w obiekcie) - plan JUCE ma jednego użytkownika
+struct FFTPlan
+{
+    FFTPlan(int order, FFTEngine fftEngine) :
+        engine(fftEngine),
+        size(1 << order)
+    {
+        if (engine == FFTEngine::inTree)
+        {
+            realFFT = std::make_unique<const RealFFT>(order);
+            complexFFT = std::make_unique<const ComplexFFT>(order);
+        }
+        else
+        {
+            juceFFT = std::make_unique<const juce::dsp::FFT>(order);
+        }
+    }
+
+    int getSize() const { return size; }
+
+    //widmo zespolone sygnału rzeczywistego (np. przetwarzanie w dziedzinie częstotliwości) - układ jak w juce::dsp::FFT:
+    //wejście size próbek w data (bufor 2 * size), wynik size / 2 + 1 (lub size) par re/im
+    void performRealOnlyForwardTransform(float* data, bool onlyCalculateNonNegativeFrequencies = false) const
+    {
+        if (realFFT != nullptr)
+            realFFT->performRealOnlyForwardTransform(data, onlyCalculateNonNegativeFrequencies);
+        else
+            juceFFT->performRealOnlyForwardTransform(data, onlyCalculateNonNegativeFrequencies);
+    }
+
+    //dwa kanały rzeczywiste jedną zespoloną FFT: z = l + i r, widma rozdzielane z symetrii sprzężonej
+    //L[k] = (Z[k] + Z*[N-k]) / 2, R[k] = (Z[k] - Z*[N-k]) / 2i
+    //wejście: po size próbek w left i right (bufory 2 * size), scratch 2 * size
+    //wyjście: moc widma |X[k]|^2 w left[0..size / 2] i right[0..size / 2] (bez pierwiastka - dB liczy FastDecibels)
+    void performStereoPowerSpectrumTransform(float* left, float* right, float* scratch) const
+    {
+        if (complexFFT != nullptr)
+        {
+            complexFFT->perform(left, right, scratch, scratch + size);
+            separateStereoPower(left, right, [left, right](int k) { return std::complex<float>(left[k], right[k]); });
+        }
+        else
+        {
+            for (int i = 0; i < size; ++i)
+            {
+                scratch[2 * i] = left[i];
+                scratch[2 * i + 1] = right[i];
+            }
+
+            auto* spectrum = reinterpret_cast<juce::dsp::Complex<float>*>(left);
+            juceFFT->perform(reinterpret_cast<const juce::dsp::Complex<float>*>(scratch), spectrum, false);
+            separateStereoPower(left, right, [spectrum](int k) { return spectrum[k]; });
+        }
+    }
+
+    const FFTEngine engine;
+    const int size;
+private:
+    //k rośnie, a czytane są tylko Z[k] i Z[N-k] (N-k >= size / 2) - zapis wyników w miejscu jest bezpieczny
+    template<typename GetBin>
+    void separateStereoPower(float* left, float* right, GetBin getBin) const
+    {
+        for (int k = 0; k <= size / 2; ++k)
+        {
+            const auto zk = getBin(k);
+            const auto zj = getBin((size - k) & (size - 1));
+
+            left[k] = 0.25f * std::norm(zk + std::conj(zj));
+            right[k] = 0.25f * std::norm(zk - std::conj(zj));
+        }
+    }
+
+    std::unique_ptr<const juce::dsp::FFT> juceFFT;
+    std::unique_ptr<const RealFFT> realFFT;
+    std::unique_ptr<const ComplexFFT> complexFFT;
+};
+
+//okna i plany własnej FFT współdzielone przez wszystkie instancje w procesie (juce::SharedResourcePointer),
+//tworzone przy pierwszym użyciu danego rzędu (i rodzaju okna) i tylko do odczytu - bezpieczne z wielu wątków
+struct FFTPlanCache
+{
+    using WindowType = juce::dsp::WindowingFunction<float>::WindowingMethod;
+
+    //plan JUCE za każdym razem nowy - wątki puli analizy nie mogą dzielić jednego juce::dsp::FFT
+    std::shared_ptr<const FFTPlan> getPlan(FFTOrder order, FFTEngine engine = defaultFFTEngine)
+    {
+        if (engine == FFTEngine::juceFFT)
+            return std::make_shared<const FFTPlan>(order, engine);
+
+        const juce::ScopedLock sl(lock);
+        auto& plan = plans[getIndex(order)];
+        if (plan == nullptr)
+            plan = std::make_shared<const FFTPlan>(order, engine);
+
+        return plan;
+    }
+
+    //okno znormalizowane (wzmocnienie koherentne 1)
+    std::shared_ptr<const std::vector<float>> getWindow(FFTOrder order, WindowType type)
+    {
+        const juce::ScopedLock sl(lock);
+        auto& window = windows[(size_t)type][getIndex(order)];
+        if (window == nullptr)
+        {
+            auto table = std::make_shared<std::vector<float>>((size_t)1 << order);
+            juce::dsp::WindowingFunction<float>::fillWindowingTables(table->data(), table->size(), type, true);
+            window = std::move(table);
+        }
+
+        return window;
+    }
+private:
+    static constexpr size_t numOrders = order32768 - order512 + 1;
+
+    static size_t getIndex(FFTOrder order)
+    {
+        jassert(order >= order512 && order <= order32768);
+        return (size_t)(order - order512);
+    }
+
+    juce::CriticalSection lock;
+    std::array<std::shared_ptr<const FFTPlan>, numOrders> plans;
+    std::array<std::array<std::shared_ptr<const std::vector<float>>, numOrders>, juce::dsp::WindowingFunction<float>::numWindowingMethods> windows;
+};
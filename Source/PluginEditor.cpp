@@ -10,14 +10,31 @@
 #include "PluginEditor.h"
 
 int windowWidth = 1000; 
-int windowHeight = 600;
+int windowHeight = 720;
 
 //==============================================================================
+//kolory lewego i prawego kanału dla punktu odczytu; pasma we własnych kolorach, prawy kanał jaśniejszy
+static std::array<juce::Colour, 2> getAnalyzerTapColours(AnalyzerTap tap)
+{
+    using juce::Colour;
+
+    switch (tap)
+    {
+        case AnalyzerTap::pre: return { Colour(97u, 18u, 167u), Colour(215u, 201u, 134u) }; //purple-
+        case AnalyzerTap::low: return { Colour(220u, 70u, 60u), Colour(220u, 70u, 60u).brighter(0.4f) };
+        case AnalyzerTap::lowMid: return { Colour(230u, 170u, 40u), Colour(230u, 170u, 40u).brighter(0.4f) };
+        case AnalyzerTap::highMid: return { Colour(60u, 190u, 100u), Colour(60u, 190u, 100u).brighter(0.4f) };
+        case AnalyzerTap::high: return { Colour(60u, 140u, 230u), Colour(60u, 140u, 230u).brighter(0.4f) };
+        default: return { Colour(200u, 200u, 200u), Colour(240u, 240u, 240u) };
+    }
+}
+
 SpectrumAnalyzer::SpectrumAnalyzer(Projekt_zespoowy_2022AudioProcessor& p) :
-    audioProcessor(p),
-    leftPathProducer(audioProcessor.leftChannelFifo),
-    rightPathProducer(audioProcessor.rightChannelFifo)
+    audioProcessor(p)
 {
+    for (auto& slot : analyzerSlots)
+        slot = std::make_unique<AnalyzerSlot>(audioProcessor, AnalyzerTap::pre);
+
     const auto& params = audioProcessor.getParameters();
     for (auto param : params)
     {
@@ -42,11 +59,22 @@ SpectrumAnalyzer::SpectrumAnalyzer(Projekt_zespoowy_2022AudioProcessor& p) :
     floatHelper(highMidThresholdParam, Names::Threshold_HighMid);
     floatHelper(highThresholdParam, Names::Threshold_High);
 
+    setupAnalyzerSettingsControls();
+    setupTapButtons();
+
     startTimerHz(60);
+
+    //domyślnie sygnał wejściowy
+    if (!activateTap(AnalyzerTap::pre))
+        rejectedTap = AnalyzerTap::pre;
+    updateTapButtons();
 }
 
 SpectrumAnalyzer::~SpectrumAnalyzer()
 {
+    for (auto& slot : analyzerSlots)
+        deactivateSlot(*slot);
+
     const auto& params = audioProcessor.getParameters();
     for (auto param : params)
     {
@@ -67,17 +95,41 @@ void SpectrumAnalyzer::paint(juce::Graphics& g)
 
     if (shouldShowFFTAnalysis)
     {
-        auto leftChannelFFTPath = leftPathProducer.getPath();
-        leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
+        const auto toResponseArea = AffineTransform().translation(responseArea.getX(), 0);
 
-        g.setColour(Colour(97u, 18u, 167u)); //purple-
-        g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
+        for (auto& slot : analyzerSlots)
+        {
+            if (!slot->active)
+                continue;
+
+            const auto& frame = slot->frame;
+            const auto colours = getAnalyzerTapColours(slot->tap);
+
+            //szczyty pod spodem, przygaszone
+            auto leftPeakPath = frame.leftPeak;
+            leftPeakPath.applyTransform(toResponseArea);
+
+            g.setColour(colours[0].withAlpha(0.5f));
+            g.strokePath(leftPeakPath, PathStrokeType(1.f));
+
+            auto rightPeakPath = frame.rightPeak;
+            rightPeakPath.applyTransform(toResponseArea);
 
-        auto rightChannelFFTPath = rightPathProducer.getPath();
-        rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0));
+            g.setColour(colours[1].withAlpha(0.5f));
+            g.strokePath(rightPeakPath, PathStrokeType(1.f));
 
-        g.setColour(Colour(215u, 201u, 134u));
-        g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
+            auto leftChannelFFTPath = frame.left;
+            leftChannelFFTPath.applyTransform(toResponseArea);
+
+            g.setColour(colours[0]);
+            g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
+
+            auto rightChannelFFTPath = frame.right;
+            rightChannelFFTPath.applyTransform(toResponseArea);
+
+            g.setColour(colours[1]);
+            g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
+        }
     }
 
     //Path border;
@@ -129,11 +181,21 @@ void SpectrumAnalyzer::drawCrossover(juce::Graphics& g)
     };
 
     auto zeroDb = mapY(0.f);
-    g.setColour(Colours::hotpink.withAlpha(0.3f));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(left, zeroDb, lowX, mapY(lowBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(lowX, zeroDb, midX, mapY(lowMidBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(midX, zeroDb, highX, mapY(highMidBandGR)));
-    g.fillRect(Rectangle<float>::leftTopRightBottom(highX, zeroDb, right, mapY(highBandGR)));
+    const std::array<float, 5> bandEdges{ (float)left, lowX, midX, highX, (float)right };
+    for (size_t i = 0; i < gainReductionMax.size(); ++i)
+    {
+        g.setColour(Colours::hotpink.withAlpha(0.3f));
+        g.fillRect(Rectangle<float>::leftTopRightBottom(bandEdges[i], zeroDb, bandEdges[i + 1], mapY(gainReductionMax[i].getValue())));
+
+        g.setColour(Colours::hotpink);
+        g.drawHorizontalLine(roundToInt(mapY(gainReductionMean[i].getValue())), bandEdges[i], bandEdges[i + 1]);
+
+        if (gainReductionMax[i].getPeak() < 0.f)
+        {
+            g.setColour(Colours::white);
+            g.drawHorizontalLine(roundToInt(mapY(gainReductionMax[i].getPeak())), bandEdges[i], bandEdges[i + 1]);
+        }
+    }
 
     g.setColour(Colours::cyan);
     g.drawHorizontalLine(mapY(lowThresholdParam->get()), left, lowX);
@@ -142,25 +204,31 @@ void SpectrumAnalyzer::drawCrossover(juce::Graphics& g)
     g.drawHorizontalLine(mapY(highThresholdParam->get()), highX, right);
 }
 
-void SpectrumAnalyzer::update(const std::vector<float>& values)
+void SpectrumAnalyzer::update(const MeterSnapshot& meters)
 {
-    jassert(values.size() == 8);
-    enum
+    for (size_t i = 0; i < meters.bands.size(); ++i)
     {
-        LowBandIn, LowBandOut,
-        LowMidBandIn, LowMidBandOut,
-        HighMidBandIn, HighMidBandOut,
-        HighBandIn, HighBandOut
-    };
-
-    lowBandGR = values[LowBandOut] - values[LowBandIn];
-    lowMidBandGR = values[LowMidBandOut] - values[LowMidBandIn];
-    highMidBandGR = values[HighMidBandOut] - values[HighMidBandIn];
-    highBandGR = values[HighBandOut] - values[HighBandIn];
+        gainReductionMax[i].process(meters.bands[i].gainReductionMaxDb);
+        gainReductionMean[i].process(meters.bands[i].gainReductionMeanDb);
+    }
 
     repaint();
 }
 
+void SpectrumAnalyzer::setGainReductionBallistics(float attackMs, float releaseMs, float updateRateHz)
+{
+    for (auto& meter : gainReductionMax)
+        meter.setTimes(attackMs, releaseMs, updateRateHz);
+    for (auto& meter : gainReductionMean)
+        meter.setTimes(attackMs, releaseMs, updateRateHz);
+}
+
+void SpectrumAnalyzer::setGainReductionPeakHold(float holdMs, float decayDbPerSecond, float updateRateHz)
+{
+    for (auto& meter : gainReductionMax)
+        meter.setPeakHold(holdMs, decayDbPerSecond, updateRateHz);
+}
+
 std::vector<float> SpectrumAnalyzer::getFrequencies()
 {
     return std::vector<float>
@@ -303,12 +371,239 @@ void SpectrumAnalyzer::drawTextLabels(juce::Graphics& g)
 }
 
 void SpectrumAnalyzer::resized()
+{
+    auto controlsArea = getAnalysisArea().removeFromTop(18);
+
+    auto settingsArea = controlsArea.removeFromRight(3 * 100);
+    for (auto* box : { &fftOrderBox, &windowBox, &qualityBox })
+        box->setBounds(settingsArea.removeFromLeft(100).reduced(1));
+
+    for (auto& button : tapButtons)
+        button.setBounds(controlsArea.removeFromLeft(44).reduced(1));
+
+    const auto geometry = getAnalyzerGeometry();
+    for (auto& slot : analyzerSlots)
+        slot->analysisClient.setGeometry(geometry);
+}
+
+void SpectrumAnalyzer::toggleAnalysisEnablement(bool enabled)
+{
+    if (enabled == shouldShowFFTAnalysis)
+        return;
+
+    shouldShowFFTAnalysis = enabled;
+
+    //wyłączona analiza nie czyta FIFO - procesor może przestać je zasilać
+    //(FIFO gotowe przed wznowieniem analizy, zwalniane z opóźnieniem dłuższym niż runda puli)
+    for (auto& slot : analyzerSlots)
+    {
+        if (!slot->active)
+            continue;
+
+        if (!enabled)
+        {
+            slot->analysisClient.setEnabled(false);
+            audioProcessor.removeAnalyzerConsumer(slot->tap);
+        }
+        else if (audioProcessor.addAnalyzerConsumer(slot->tap))
+        {
+            slot->analysisClient.setEnabled(true);
+        }
+        else
+        {
+            //limit zajęty w międzyczasie (np. drugi edytor) - punkt odczytu odpada
+            analysisService->removeClient(&slot->analysisClient);
+            slot->active = false;
+            rejectedTap = slot->tap;
+        }
+    }
+
+    updateTapButtons();
+}
+
+bool SpectrumAnalyzer::activateTap(AnalyzerTap tap)
+{
+    AnalyzerSlot* target = nullptr;
+    for (auto& slot : analyzerSlots)
+    {
+        if (slot->active && slot->tap == tap)
+            return true;
+
+        if (target == nullptr || (target->active && (!slot->active || slot->activationOrder < target->activationOrder)))
+            target = slot.get();
+    }
+
+    //przy wyłączonej analizie odbiorcy nie są rejestrowane - slot można przełączyć bez sprawdzania
+    if (!shouldShowFFTAnalysis)
+    {
+        deactivateSlot(*target);
+        attachSlot(*target, tap);
+        return true;
+    }
+
+    //sprawdzenie przed zwolnieniem slotu - odmowa nie gasi aktywnego punktu odczytu
+    const auto wasActive = target->active;
+    const auto previousTap = target->tap;
+    const auto previousOrder = target->activationOrder;
+    const auto canAdd = wasActive ? audioProcessor.canAddAnalyzerConsumer(tap, previousTap)
+                                  : audioProcessor.canAddAnalyzerConsumer(tap);
+    if (!canAdd)
+        return false;
+
+    deactivateSlot(*target);
+
+    //FIFO gotowe, zanim pula zacznie je czytać
+    if (audioProcessor.addAnalyzerConsumer(tap))
+    {
+        attachSlot(*target, tap);
+        return true;
+    }
+
+    //limit zajęty między sprawdzeniem a rejestracją (inny edytor) - powrót do poprzedniego punktu odczytu
+    if (wasActive && audioProcessor.addAnalyzerConsumer(previousTap))
+    {
+        attachSlot(*target, previousTap);
+        target->activationOrder = previousOrder;
+    }
+
+    return false;
+}
+
+void SpectrumAnalyzer::attachSlot(AnalyzerSlot& slot, AnalyzerTap tap)
+{
+    slot.tap = tap;
+    slot.pathProducer.setSource(audioProcessor.getAnalyzerFifo(tap, Channel::Left),
+                                audioProcessor.getAnalyzerFifo(tap, Channel::Right));
+    slot.frame = {};
+    slot.active = true;
+    slot.activationOrder = ++slotActivations;
+
+    auto& client = slot.analysisClient;
+    client.setEnabled(shouldShowFFTAnalysis);
+    client.setSettings(getAnalyzerSettings());
+    client.setGeometry(getAnalyzerGeometry());
+    analysisService->addClient(&client);
+}
+
+void SpectrumAnalyzer::deactivateSlot(AnalyzerSlot& slot)
+{
+    if (!slot.active)
+        return;
+
+    //pula czyta FIFO procesora - klient wypisany (i nie wykonywany) przed wyrejestrowaniem odbiorcy
+    analysisService->removeClient(&slot.analysisClient);
+
+    if (shouldShowFFTAnalysis)
+        audioProcessor.removeAnalyzerConsumer(slot.tap);
+
+    slot.active = false;
+}
+
+void SpectrumAnalyzer::setupTapButtons()
+{
+    const char* names[] = { "Pre", "Low", "L-Mid", "H-Mid", "High", "Post" };
+    static_assert(std::size(names) == (size_t)AnalyzerTap::numTaps, "one button per analyzer tap");
+
+    for (size_t i = 0; i < tapButtons.size(); ++i)
+    {
+        auto& button = tapButtons[i];
+        const auto tap = static_cast<AnalyzerTap>(i);
+
+        button.setButtonText(names[i]);
+        button.onClick = [this, tap]
+        {
+            auto deactivated = false;
+            for (auto& slot : analyzerSlots)
+            {
+                if (slot->active && slot->tap == tap)
+                {
+                    deactivateSlot(*slot);
+                    deactivated = true;
+                }
+            }
+
+            rejectedTap = deactivated || activateTap(tap) ? AnalyzerTap::numTaps : tap;
+            updateTapButtons();
+        };
+        addAndMakeVisible(button);
+    }
+}
+
+void SpectrumAnalyzer::updateTapButtons()
+{
+    for (size_t i = 0; i < tapButtons.size(); ++i)
+    {
+        auto isActive = false;
+        for (auto& slot : analyzerSlots)
+            isActive = isActive || (slot->active && slot->tap == static_cast<AnalyzerTap>(i));
+
+        auto& button = tapButtons[i];
+        const auto isRejected = rejectedTap == static_cast<AnalyzerTap>(i);
+        button.setToggleState(isActive, juce::dontSendNotification);
+        if (isRejected)
+            button.setColour(juce::TextButton::textColourOffId, juce::Colours::orangered);
+        else
+            button.removeColour(juce::TextButton::textColourOffId);
+        button.setTooltip(isRejected ? "Analyzer limit reached - close another analyzer tap or editor" : juce::String());
+    }
+}
+
+void SpectrumAnalyzer::setupAnalyzerSettingsControls()
+{
+    using Window = juce::dsp::WindowingFunction<float>;
+
+    //identyfikatory: rząd FFT, rodzaj okna + 1, jakość + 1
+    fftOrderBox.addItem("FFT 2048", FFTOrder::order2048);
+    fftOrderBox.addItem("FFT 4096", FFTOrder::order4096);
+    fftOrderBox.addItem("FFT 8192", FFTOrder::order8192);
+
+    windowBox.addItem("Hann", Window::hann + 1);
+    windowBox.addItem("Blackman-Harris", Window::blackmanHarris + 1);
+    windowBox.addItem("Flat top", Window::flatTop + 1);
+
+    qualityBox.addItem("Fast", (int)AnalyzerQuality::fast + 1);
+    qualityBox.addItem("Normal", (int)AnalyzerQuality::normal + 1);
+    qualityBox.addItem("Smooth", (int)AnalyzerQuality::smooth + 1);
+
+    const AnalyzerSettings defaults;
+    fftOrderBox.setSelectedId(defaults.order, juce::dontSendNotification);
+    windowBox.setSelectedId(defaults.window + 1, juce::dontSendNotification);
+    qualityBox.setSelectedId((int)defaults.quality + 1, juce::dontSendNotification);
+
+    for (auto* box : { &fftOrderBox, &windowBox, &qualityBox })
+    {
+        box->onChange = [this]
+        {
+            const auto settings = getAnalyzerSettings();
+            for (auto& slot : analyzerSlots)
+                slot->analysisClient.setSettings(settings);
+        };
+        addAndMakeVisible(*box);
+    }
+}
+
+AnalyzerSettings SpectrumAnalyzer::getAnalyzerSettings() const
+{
+    AnalyzerSettings settings;
+    settings.order = static_cast<FFTOrder>(fftOrderBox.getSelectedId());
+    settings.window = static_cast<FFTPlanCache::WindowType>(windowBox.getSelectedId() - 1);
+    settings.quality = static_cast<AnalyzerQuality>(qualityBox.getSelectedId() - 1);
+    return settings;
+}
+
+AnalyzerGeometry SpectrumAnalyzer::getAnalyzerGeometry()
 {
     using namespace juce;
+    AnalyzerGeometry geometry;
+
     auto fftBounds = getAnalysisArea().toFloat();
-    auto negInf = jmap(getLocalBounds().toFloat().getBottom(), fftBounds.getBottom(), fftBounds.getY(), -48.f, 12.f);
-    leftPathProducer.updateNegativeInfinity(negInf);
-    rightPathProducer.updateNegativeInfinity(negInf);
+    geometry.negativeInfinity = jmap(getLocalBounds().toFloat().getBottom(), fftBounds.getBottom(), fftBounds.getY(), -48.f, 12.f);
+
+    fftBounds.setBottom(getLocalBounds().getBottom());
+    geometry.fftBounds = fftBounds;
+    geometry.sampleRate = audioProcessor.getSampleRate();
+
+    return geometry;
 }
 
 void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
@@ -316,63 +611,377 @@ void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
     parametersChanged.set(true);
 }
 
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+void PathProducer::prepareLowBand(int factor)
+{
+    for (auto& decimator : decimators)
+        decimator.prepare(factor);
+
+    decimated.resize((size_t)(decimationChunk / factor + 1));
+    engine->prepareLowBand();
+    hasLowBandFrame = false;
+}
+
+void PathProducer::writeLowBand(int channel, const float* data, int numSamples)
 {
-    juce::AudioBuffer<float> tempIncomingBuffer;
-    while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0)
+    for (int done = 0; done < numSamples; done += decimationChunk)
     {
-        if (leftChannelFifo->getAudioBuffer(tempIncomingBuffer))
+        const auto numIn = juce::jmin(decimationChunk, numSamples - done);
+        const auto numOut = decimators[(size_t)channel].process(data + done, numIn, decimated.data());
+        engine->lowStft.write(channel, decimated.data(), numOut, numDecimated);
+        numDecimated += numOut;
+    }
+}
+
+void PathProducer::setEngine(std::unique_ptr<AnalysisEngine> newEngine)
+{
+    engine = std::move(newEngine);
+    hasLowBandFrame = false;
+}
+
+void PathProducer::readFifos(bool useLowBand)
+{
+    auto& stft = engine->stft;
+    auto& lowStft = engine->lowStft;
+
+    //oba kanały przesuwane o tyle samo próbek - ramki L i P zawsze z tego samego odcinka czasu
+    //próbki wprost z pierścieni, starsze niż pojemność historii są pomijane
+    auto numSamples = channelFifos[0]->getNumSamplesAvailable();
+    for (auto* fifo : channelFifos)
+        numSamples = juce::jmin(numSamples, fifo->getNumSamplesAvailable());
+
+    if (numSamples > 0)
+    {
+        const auto skip = juce::jmax(0, numSamples - stft.getCapacity());
+
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            auto size = tempIncomingBuffer.getNumSamples();
+            const auto view = channelFifos[(size_t)ch]->getReadView(numSamples);
+            const float* segments[] = { view.data1, view.data2 };
+            const int sizes[] = { view.size1, view.size2 };
 
-            jassert(size <= monoBuffer.getNumSamples());
-            size = juce::jmin(size, monoBuffer.getNumSamples());
+            auto position = 0;
+            numDecimated = 0;
+            for (int i = 0; i < 2; ++i)
+            {
+                const auto start = juce::jlimit(0, sizes[i], skip - position);
+                if (start < sizes[i])
+                {
+                    stft.write(ch, segments[i] + start, sizes[i] - start, position + start);
+
+                    if (useLowBand)
+                        writeLowBand(ch, segments[i] + start, sizes[i] - start);
+                }
+
+                position += sizes[i];
+            }
+
+            channelFifos[(size_t)ch]->finishedRead(numSamples);
+        }
+
+        stft.advance(numSamples);
+
+        //decymatory obu kanałów w tej samej fazie - ta sama liczba próbek
+        if (useLowBand)
+            lowStft.advance(numDecimated);
+    }
+}
+
+bool PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+{
+    //decymacja do ~6 kHz niezależnie od częstotliwości próbkowania
+    const auto useLowBand = multiResolution && sampleRate > 0.0;
+    if (useLowBand)
+    {
+        const auto factor = juce::jmax(2, juce::nextPowerOfTwo(juce::roundToInt(sampleRate / 6000.0)));
+        if (factor != decimators[0].getFactor())
+            prepareLowBand(factor);
+    }
+    else
+    {
+        hasLowBandFrame = false;
+    }
+
+    //prepareToPlay może właśnie przebudowywać pierścienie - wtedy próbki zostają do następnej rundy
+    {
+        const juce::ScopedTryLock leftLock(channelFifos[0]->getReadLock());
+        const juce::ScopedTryLock rightLock(channelFifos[1]->getReadLock());
+        if (leftLock.isLocked() && rightLock.isLocked())
+            readFifos(useLowBand);
+    }
 
-            auto writePointer = monoBuffer.getWritePointer(0, 0);
-            auto readPointer = monoBuffer.getReadPointer(0, size);
+    auto& stft = engine->stft;
+    auto& lowStft = engine->lowStft;
 
-            std::copy(readPointer, readPointer + (monoBuffer.getNumSamples() - size), writePointer);
+    //ścieżki odświeżane z ramką pełnego pasma; niskie pasmo liczone, gdy ma zaległą ramkę
+    if (!stft.isFrameDue())
+        return false;
 
-            //juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, 0),
-            //    monoBuffer.getReadPointer(0, size),
-            //    monoBuffer.getNumSamples() - size);
+    auto& fftDataGenerator = engine->fftDataGenerator;
+    auto& lowFFTDataGenerator = engine->lowFFTDataGenerator;
 
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                tempIncomingBuffer.getReadPointer(0, 0),
-                size);
+    float* frames[] = { fftDataGenerator.getFrameBuffer(0), fftDataGenerator.getFrameBuffer(1) };
+    const auto elapsedSamples = stft.readFrame(frames);
+    fftDataGenerator.produceFFTDataForRendering(negativeInfinity);
 
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInfinity);
+    if (useLowBand && lowStft.isFrameDue())
+    {
+        float* lowFrames[] = { lowFFTDataGenerator.getFrameBuffer(0), lowFFTDataGenerator.getFrameBuffer(1) };
+        lowStft.readFrame(lowFrames);
+        lowFFTDataGenerator.produceFFTDataForRendering(negativeInfinity);
+        hasLowBandFrame = true;
+    }
+
+    const auto fftSize = fftDataGenerator.getFFTSize();
+    const auto binWidth = float(sampleRate / double(fftSize));
+
+    //stała czasowa uśredniania i opadanie szczytów niezależne od zakładki i pominiętych ramek
+    const auto elapsedSeconds = float(elapsedSamples / sampleRate);
+    const auto averagingMs = engine->settings.getAveragingMs();
+    const auto averaging = averagingMs > 0.f
+        ? std::exp(-1000.f * elapsedSeconds / averagingMs)
+        : 0.f;
+    const auto peakDecayDb = peakDecayDbPerSecond * elapsedSeconds;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        std::array<SpectrumBand, AnalyzerPathGenerator<juce::Path>::maxBands> bands;
+        auto numBands = 0;
+
+        if (hasLowBandFrame)
+        {
+            const auto lowSampleRate = float(sampleRate / decimators[0].getFactor());
+            auto& low = bands[(size_t)numBands++];
+            low.data = lowFFTDataGenerator.getFFTData(ch).data();
+            low.fftSize = lowFFTDataGenerator.getFFTSize();
+            low.binWidth = lowSampleRate / float(low.fftSize);
+            low.upperFrequency = lowSampleRate * lowBandCrossover;
+        }
+
+        auto& full = bands[(size_t)numBands++];
+        full.data = fftDataGenerator.getFFTData(ch).data();
+        full.fftSize = fftSize;
+        full.binWidth = binWidth;
+
+        pathGenerators[(size_t)ch].generatePath(bands.data(), numBands, fftBounds, negativeInfinity, averaging, peakDecayDb,
+            channelPaths[(size_t)ch], peakPaths[(size_t)ch]);
+    }
+
+    return true;
+}
+
+void SpectrumAnalysisClient::analyse()
+{
+    geometry.pull(current);
+
+    //przebudowa na wątku puli - GUI i wątek audio nie alokują, a ramki do końca pochodzą ze starego silnika
+    AnalyzerSettings requested;
+    if (settings.pull(requested) && requested != pathProducer.getSettings())
+        pathProducer.setEngine(std::make_unique<AnalysisEngine>(requested));
+
+    if (!enabled.load() || current.sampleRate <= 0.0 || current.fftBounds.isEmpty())
+        return;
+
+    pathProducer.updateNegativeInfinity(current.negativeInfinity);
+
+    if (pathProducer.process(current.fftBounds, current.sampleRate))
+        frames.push({ pathProducer.getPath(0), pathProducer.getPath(1), pathProducer.getPeakPath(0), pathProducer.getPeakPath(1) });
+}
+
+SpectrumAnalysisService::SpectrumAnalysisService()
+{
+    //mała pula - analiza nie może konkurować z wątkami audio hosta
+    const auto numWorkers = juce::jlimit(1, 3, juce::SystemStats::getNumCpus() / 2);
+
+    roundBudgetTicks = juce::int64(maxCpuShare * double(juce::Time::getHighResolutionTicksPerSecond()) / roundRateHz);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        queues.push_back(std::make_unique<JobQueue>());
+        workers.push_back(std::make_unique<Worker>(*this, i));
+    }
+
+    for (auto& worker : workers)
+        worker->startThread(juce::Thread::Priority::low);
+}
+
+SpectrumAnalysisService::~SpectrumAnalysisService()
+{
+    for (auto& worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->notify();
+    }
+
+    for (auto& worker : workers)
+        worker->stopThread(1000);
+}
+
+void SpectrumAnalysisService::addClient(SpectrumAnalysisClient* client)
+{
+    const juce::ScopedLock sl(clientsLock);
+    clients.push_back(client);
+}
+
+void SpectrumAnalysisService::removeClient(SpectrumAnalysisClient* client)
+{
+    {
+        const juce::ScopedLock sl(clientsLock);
+        clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+
+        for (auto& queue : queues)
+        {
+            const juce::SpinLock::ScopedLockType ql(queue->lock);
+            queue->jobs.erase(std::remove(queue->jobs.begin(), queue->jobs.end(), client), queue->jobs.end());
         }
     }
 
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
-    const auto binWidth = sampleRate / double(fftSize);
+    //zadanie zdjęte z kolejki przed wypisaniem ma już ustawione running (pod blokadą kolejki)
+    while (client->running.load())
+        juce::Thread::sleep(1);
+}
+
+SpectrumAnalysisClient* SpectrumAnalysisService::takeJob(int workerIndex)
+{
+    //limit CPU: reszta kolejki czeka do następnej rundy
+    if (ticksUsedThisRound.load() >= roundBudgetTicks)
+        return nullptr;
 
-    while (leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
+    const auto numQueues = (int)queues.size();
+    for (int i = 0; i < numQueues; ++i)
     {
-        std::vector<float> fftData;
-        if (leftChannelFFTDataGenerator.getFFTData(fftData))
+        //najpierw własna kolejka od początku (najwyższy priorytet), potem podkradanie od końca cudzych
+        auto& queue = *queues[(size_t)((workerIndex + i) % numQueues)];
+        const juce::SpinLock::ScopedLockType ql(queue.lock);
+
+        if (queue.jobs.empty())
+            continue;
+
+        SpectrumAnalysisClient* client = nullptr;
+        if (i == 0)
         {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negativeInfinity);
+            client = queue.jobs.front();
+            queue.jobs.pop_front();
         }
+        else
+        {
+            client = queue.jobs.back();
+            queue.jobs.pop_back();
+        }
+
+        client->running.store(true);
+        return client;
+    }
+
+    return nullptr;
+}
+
+void SpectrumAnalysisService::runJob(SpectrumAnalysisClient& client)
+{
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    client.analyse();
+    client.skippedRounds.store(0);
+
+    ticksUsedThisRound.fetch_add(juce::Time::getHighResolutionTicks() - start);
+    client.running.store(false);
+}
+
+bool SpectrumAnalysisService::scheduleRoundIfDue()
+{
+    const auto now = juce::Time::getMillisecondCounterHiRes();
+    if (now < nextRoundMs.load())
+        return false;
+
+    const auto period = 1000.0 / roundRateHz;
+    nextRoundMs.store(juce::jmax(nextRoundMs.load() + period, now));
+    ticksUsedThisRound.store(0);
+
+    const juce::ScopedLock sl(clientsLock);
+
+    //czego nie zdążono w poprzedniej rundzie, dostaje wyższy priorytet
+    for (auto& queue : queues)
+    {
+        const juce::SpinLock::ScopedLockType ql(queue->lock);
+        for (auto* client : queue->jobs)
+            client->skippedRounds.fetch_add(1);
+
+        queue->jobs.clear();
     }
 
-    while (pathProducer.getNumPathsAvailable() > 0)
+    std::vector<SpectrumAnalysisClient*> due;
+    for (auto* client : clients)
+    {
+        if (client->wantsAnalysis() && !client->running.load())
+            due.push_back(client);
+    }
+
+    std::stable_sort(due.begin(), due.end(), [](const SpectrumAnalysisClient* a, const SpectrumAnalysisClient* b)
+        {
+            if (a->isFocused() != b->isFocused())
+                return a->isFocused();
+            return a->skippedRounds.load() > b->skippedRounds.load();
+        });
+
+    for (size_t i = 0; i < due.size(); ++i)
+    {
+        auto& queue = *queues[i % queues.size()];
+        const juce::SpinLock::ScopedLockType ql(queue.lock);
+        queue.jobs.push_back(due[i]);
+    }
+
+    for (auto& worker : workers)
+        worker->notify();
+
+    return true;
+}
+
+int SpectrumAnalysisService::getMillisecondsToNextRound() const
+{
+    return juce::jmax(1, (int)(nextRoundMs.load() - juce::Time::getMillisecondCounterHiRes()));
+}
+
+void SpectrumAnalysisService::Worker::run()
+{
+    while (!threadShouldExit())
     {
-        pathProducer.getPath(leftChannelFFTPath);
+        if (auto* client = service.takeJob(index))
+        {
+            service.runJob(*client);
+            continue;
+        }
+
+        //pierwszy wątek odmierza rundy, pozostałe czekają na powiadomienie
+        if (index == 0 && service.scheduleRoundIfDue())
+            continue;
+
+        wait(index == 0 ? service.getMillisecondsToNextRound() : 100);
     }
 }
 
 void SpectrumAnalyzer::timerCallback()
 {
-    if (shouldShowFFTAnalysis)
+    //analiza działa we wspólnej puli wątków - tu tylko geometria (częstotliwość próbkowania może się zmienić)
+    //i odbiór najnowszej gotowej ramki
+    //niewidoczne analizatory nie dostają czasu puli, aktywne okno ma pierwszeństwo
+    auto* peer = getPeer();
+    const auto showing = isShowing();
+    const auto focused = peer != nullptr && peer->isFocused();
+    const auto geometry = getAnalyzerGeometry();
+
+    for (auto& slot : analyzerSlots)
     {
-        auto fftBounds = getAnalysisArea().toFloat();
-        fftBounds.setBottom(getLocalBounds().getBottom());
-        auto sampleRate = audioProcessor.getSampleRate();
+        if (!slot->active)
+            continue;
 
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
+        auto& client = slot->analysisClient;
+        client.setShowing(showing);
+        client.setFocused(focused);
+
+        if (shouldShowFFTAnalysis)
+        {
+            client.setGeometry(geometry);
+            client.getLatestFrame(slot->frame);
+        }
     }
 
     if (parametersChanged.compareAndSetBool(false, true))
@@ -584,6 +1193,125 @@ void LookAndFeel::drawToggleButton(juce::Graphics& g,
 
     }
 }
+//==============================================================================
+GainReductionHistory::GainReductionHistory(Projekt_zespoowy_2022AudioProcessor& p) : audioProcessor(p)
+{
+    //ramki nagromadzone bez edytora są nieaktualne
+    GainReductionFrame frame;
+    while (audioProcessor.gainReductionHistory.pull(frame)) { }
+
+    resetPendingColumn();
+}
+
+void GainReductionHistory::paint(juce::Graphics& g)
+{
+    using namespace juce;
+    g.fillAll(Colours::black);
+    g.drawImageAt(historyImage, 0, 0);
+
+    g.setColour(Colours::lightgrey);
+    g.setFont(10);
+    g.drawFittedText(String(roundToInt(historySeconds)) + " s", getLocalBounds().reduced(2), Justification::topRight, 1);
+}
+
+void GainReductionHistory::resized()
+{
+    //jedyna alokacja - przy zmianie rozmiaru, historia zaczyna się od nowa
+    historyImage = juce::Image(juce::Image::ARGB, juce::jmax(1, getWidth()), juce::jmax(1, getHeight()), true);
+    resetPendingColumn();
+    pendingSeconds = 0.f;
+}
+
+void GainReductionHistory::mouseDown(const juce::MouseEvent&)
+{
+    //kliknięcie przełącza długość historii 5 -> 10 -> 20 -> 30 s
+    setHistoryLength(historySeconds >= maxHistorySeconds ? minHistorySeconds
+                                                        : juce::jmin(maxHistorySeconds, historySeconds < 10.f ? 10.f : historySeconds + 10.f));
+}
+
+void GainReductionHistory::setHistoryLength(float seconds)
+{
+    historySeconds = juce::jlimit(minHistorySeconds, maxHistorySeconds, seconds);
+    historyImage.clear(historyImage.getBounds());
+    resetPendingColumn();
+    pendingSeconds = 0.f;
+    repaint();
+}
+
+void GainReductionHistory::update()
+{
+    const auto width = historyImage.getWidth();
+    const auto secondsPerColumn = historySeconds / static_cast<float>(width);
+    auto columnsAdded = 0;
+
+    GainReductionFrame frame;
+    while (audioProcessor.gainReductionHistory.pull(frame))
+    {
+        for (size_t i = 0; i < frame.minDb.size(); ++i)
+        {
+            pendingColumn.minDb[i] = juce::jmin(pendingColumn.minDb[i], frame.minDb[i]);
+            pendingColumn.maxDb[i] = juce::jmax(pendingColumn.maxDb[i], frame.maxDb[i]);
+        }
+        pendingSeconds += frame.durationSeconds;
+
+        //blok dłuższy niż kolumna daje kilka kolumn o tej samej wartości
+        auto columnCompleted = false;
+        while (pendingSeconds >= secondsPerColumn)
+        {
+            //przesunięcie o 1 px w lewo i nowa kolumna z prawej
+            historyImage.moveImageSection(0, 0, 1, 0, width - 1, historyImage.getHeight());
+            drawColumn(pendingColumn);
+            pendingSeconds -= secondsPerColumn;
+            ++columnsAdded;
+            columnCompleted = true;
+        }
+
+        if (columnCompleted)
+            resetPendingColumn();
+    }
+
+    if (columnsAdded > 0)
+        repaint();
+}
+
+void GainReductionHistory::resetPendingColumn()
+{
+    pendingColumn.minDb.fill(0.f);
+    pendingColumn.maxDb.fill(-rangeDb);
+}
+
+void GainReductionHistory::drawColumn(const GainReductionFrame& column)
+{
+    using namespace juce;
+    const auto x = historyImage.getWidth() - 1;
+    const auto height = historyImage.getHeight();
+    const auto numBands = static_cast<int>(column.minDb.size());
+    const auto laneHeight = static_cast<float>(height) / static_cast<float>(numBands);
+
+    Graphics g(historyImage);
+    g.setColour(Colours::black);
+    g.fillRect(x, 0, 1, height);
+
+    //każde pasmo we własnym pasie, od 0 dB (góra pasa) do -rangeDb (dół)
+    g.setColour(Colours::hotpink);
+    for (auto i = 0; i < numBands; ++i)
+    {
+        auto laneTop = laneHeight * static_cast<float>(i);
+        auto mapY = [laneTop, laneHeight](float db)
+        {
+            return jmap(jlimit(-rangeDb, 0.f, db), 0.f, -rangeDb, laneTop, laneTop + laneHeight - 1.f);
+        };
+
+        auto top = mapY(jmax(column.maxDb[(size_t)i], column.minDb[(size_t)i]));
+        auto bottom = mapY(column.minDb[(size_t)i]);
+        g.drawVerticalLine(x, top, jmax(top + 1.f, bottom));
+    }
+
+    g.setColour(Colours::darkgrey);
+    for (auto i = 1; i < numBands; ++i)
+        g.drawHorizontalLine(roundToInt(laneHeight * static_cast<float>(i)), static_cast<float>(x), static_cast<float>(x + 1));
+}
+
 //==============================================================================
 void RotarySliderWithLabels::paint(juce::Graphics& g)
 {
@@ -807,7 +1535,14 @@ attackLowSlider(nullptr, "ms", "Attack"),
 releaseLowSlider(nullptr, "ms", "Release"),
 //threshLowSlider(nullptr, "dB", "Thresh"),
 ratioLowSlider(nullptr, ": 1", "Ratio"),
-kneeLowSlider(nullptr, "", "Knee")
+kneeLowSlider(nullptr, "", "Knee"),
+mixLowSlider(nullptr, "%", "Mix"),
+linkLowSlider(nullptr, "", "Link"),
+detectorLowSlider(nullptr, "", "Detector"),
+expanderThreshLowSlider(nullptr, "dB", "Exp. Thresh"),
+expanderRatioLowSlider(nullptr, ": 1", "Exp. Ratio"),
+upwardThreshLowSlider(nullptr, "dB", "Up Thresh"),
+upwardRatioLowSlider(nullptr, ": 1", "Up Ratio")
 {
     using namespace Parameters;
     const auto& parameters = GetParameters();
@@ -822,14 +1557,32 @@ kneeLowSlider(nullptr, "", "Knee")
     //threshLowSlider.changeParam(&getParamHelper(Names::Threshold_Low));
     ratioLowSlider.changeParam(&getParamHelper(Names::Ratio_Low));
     kneeLowSlider.changeParam(&getParamHelper(Names::Knee_Low));
+    mixLowSlider.changeParam(&getParamHelper(Names::Mix_Low));
+    linkLowSlider.changeParam(&getParamHelper(Names::Stereo_Link_Low));
+    detectorLowSlider.changeParam(&getParamHelper(Names::Detector_Low));
+    expanderThreshLowSlider.changeParam(&getParamHelper(Names::Expander_Threshold_Low));
+    expanderRatioLowSlider.changeParam(&getParamHelper(Names::Expander_Ratio_Low));
+    upwardThreshLowSlider.changeParam(&getParamHelper(Names::Upward_Threshold_Low));
+    upwardRatioLowSlider.changeParam(&getParamHelper(Names::Upward_Ratio_Low));
 
     addLabelPairs(attackLowSlider.labels, getParamHelper(Names::Attack_Low), "ms");
     addLabelPairs(releaseLowSlider.labels, getParamHelper(Names::Release_Low), "ms");
     //addLabelPairs(threshLowSlider.labels, getParamHelper(Names::Threshold_Low), "dB");
     addLabelPairs(kneeLowSlider.labels, getParamHelper(Names::Knee_Low), "");
+    addLabelPairs(mixLowSlider.labels, getParamHelper(Names::Mix_Low), "%");
+    addLabelPairs(expanderThreshLowSlider.labels, getParamHelper(Names::Expander_Threshold_Low), "dB");
+    addLabelPairs(upwardThreshLowSlider.labels, getParamHelper(Names::Upward_Threshold_Low), "dB");
 
     ratioLowSlider.labels.add({ 0.f, "1:1" });
     ratioLowSlider.labels.add({ 1.f, "30:1" });
+    linkLowSlider.labels.add({ 0.f, "Max" });
+    linkLowSlider.labels.add({ 1.f, "Off" });
+    detectorLowSlider.labels.add({ 0.f, "Peak" });
+    detectorLowSlider.labels.add({ 1.f, "RMS" });
+    expanderRatioLowSlider.labels.add({ 0.f, "1:1" });
+    expanderRatioLowSlider.labels.add({ 1.f, "10:1" });
+    upwardRatioLowSlider.labels.add({ 0.f, "1:1" });
+    upwardRatioLowSlider.labels.add({ 1.f, "10:1" });
 
     auto makeAttachmentHelper = [&parameters, &apvts = this->apvts](auto& attachment, const auto& name, auto& slider)
     {
@@ -841,12 +1594,26 @@ kneeLowSlider(nullptr, "", "Knee")
     makeAttachmentHelper(threshLowSliderAttachment, Names::Threshold_Low, threshLowSlider);
     makeAttachmentHelper(ratioLowSliderAttachment, Names::Ratio_Low, ratioLowSlider);
     makeAttachmentHelper(kneeLowSliderAttachment, Names::Knee_Low, kneeLowSlider);
+    makeAttachmentHelper(mixLowSliderAttachment, Names::Mix_Low, mixLowSlider);
+    makeAttachmentHelper(linkLowSliderAttachment, Names::Stereo_Link_Low, linkLowSlider);
+    makeAttachmentHelper(detectorLowSliderAttachment, Names::Detector_Low, detectorLowSlider);
+    makeAttachmentHelper(expanderThreshLowSliderAttachment, Names::Expander_Threshold_Low, expanderThreshLowSlider);
+    makeAttachmentHelper(expanderRatioLowSliderAttachment, Names::Expander_Ratio_Low, expanderRatioLowSlider);
+    makeAttachmentHelper(upwardThreshLowSliderAttachment, Names::Upward_Threshold_Low, upwardThreshLowSlider);
+    makeAttachmentHelper(upwardRatioLowSliderAttachment, Names::Upward_Ratio_Low, upwardRatioLowSlider);
 
     addAndMakeVisible(attackLowSlider);
     addAndMakeVisible(releaseLowSlider);
     addAndMakeVisible(threshLowSlider);
     addAndMakeVisible(ratioLowSlider);
     addAndMakeVisible(kneeLowSlider);
+    addAndMakeVisible(mixLowSlider);
+    addAndMakeVisible(linkLowSlider);
+    addAndMakeVisible(detectorLowSlider);
+    addAndMakeVisible(expanderThreshLowSlider);
+    addAndMakeVisible(expanderRatioLowSlider);
+    addAndMakeVisible(upwardThreshLowSlider);
+    addAndMakeVisible(upwardRatioLowSlider);
 
     addAndMakeVisible(threshLabel);
     threshLabel.setText("Thres. (dB)", juce::dontSendNotification);
@@ -855,14 +1622,20 @@ kneeLowSlider(nullptr, "", "Knee")
     bypassLowButton.setName("B");
     soloLowButton.setName("S");
     muteLowButton.setName("M");
+    autoReleaseLowButton.setName("AR");
+    autoMakeupLowButton.setName("AM");
 
     addAndMakeVisible(bypassLowButton);
     addAndMakeVisible(soloLowButton);
     addAndMakeVisible(muteLowButton);
+    addAndMakeVisible(autoReleaseLowButton);
+    addAndMakeVisible(autoMakeupLowButton);
 
     makeAttachmentHelper(muteLowAttachment, Names::Mute_Low, muteLowButton);
     makeAttachmentHelper(soloLowAttachment, Names::Solo_Low, soloLowButton);
     makeAttachmentHelper(bypassLowAttachment, Names::Bypassed_Low, bypassLowButton);
+    makeAttachmentHelper(autoReleaseLowAttachment, Names::Auto_Release_Low, autoReleaseLowButton);
+    makeAttachmentHelper(autoMakeupLowAttachment, Names::Auto_Makeup_Low, autoMakeupLowButton);
 };
 
 void BandControls::paint(juce::Graphics& g)
@@ -900,7 +1673,7 @@ void BandControls::resized()
         return flexBox;
     };
 
-    auto bandButtonControlBox = createBandButtonBox({ &muteLowButton, &soloLowButton, &bypassLowButton });
+    auto bandButtonControlBox = createBandButtonBox({ &muteLowButton, &soloLowButton, &bypassLowButton, &autoReleaseLowButton, &autoMakeupLowButton });
 
     bandButtonControlBox.performLayout(bounds.removeFromTop(30));
 
@@ -917,7 +1690,9 @@ void BandControls::resized()
     flexRow1.items.add(endCap);
     flexRow1.items.add(FlexItem(attackLowSlider).withFlex(1.f));
     flexRow1.items.add(FlexItem(releaseLowSlider).withFlex(1.f));
-    flexRow1.performLayout(bounds.removeFromTop(windowHeight * 5 / 30).reduced(5));
+    flexRow1.items.add(FlexItem(detectorLowSlider).withFlex(1.f));
+    flexRow1.items.add(FlexItem(linkLowSlider).withFlex(1.f));
+    flexRow1.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
 
     FlexBox flexRow2;
     flexRow2.flexDirection = FlexBox::Direction::row;
@@ -925,7 +1700,18 @@ void BandControls::resized()
     flexRow2.items.add(endCap);
     flexRow2.items.add(FlexItem(ratioLowSlider).withFlex(1.f));
     flexRow2.items.add(FlexItem(kneeLowSlider).withFlex(1.f));
-    flexRow2.performLayout(bounds.removeFromTop(windowHeight * 5 / 30).reduced(5));
+    flexRow2.items.add(FlexItem(mixLowSlider).withFlex(1.f));
+    flexRow2.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
+
+    FlexBox flexRow3;
+    flexRow3.flexDirection = FlexBox::Direction::row;
+    flexRow3.flexWrap = FlexBox::Wrap::noWrap;
+    flexRow3.items.add(endCap);
+    flexRow3.items.add(FlexItem(expanderThreshLowSlider).withFlex(1.f));
+    flexRow3.items.add(FlexItem(expanderRatioLowSlider).withFlex(1.f));
+    flexRow3.items.add(FlexItem(upwardThreshLowSlider).withFlex(1.f));
+    flexRow3.items.add(FlexItem(upwardRatioLowSlider).withFlex(1.f));
+    flexRow3.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
     }
 }
 
@@ -934,7 +1720,14 @@ attackLowMidSlider(nullptr, "ms", "Attack"),
 releaseLowMidSlider(nullptr, "ms", "Release"),
 //threshLowMidSlider(nullptr, "dB", "Thresh"),
 ratioLowMidSlider(nullptr, ": 1", "Ratio"),
-kneeLowMidSlider(nullptr, "", "Knee")
+kneeLowMidSlider(nullptr, "", "Knee"),
+mixLowMidSlider(nullptr, "%", "Mix"),
+linkLowMidSlider(nullptr, "", "Link"),
+detectorLowMidSlider(nullptr, "", "Detector"),
+expanderThreshLowMidSlider(nullptr, "dB", "Exp. Thresh"),
+expanderRatioLowMidSlider(nullptr, ": 1", "Exp. Ratio"),
+upwardThreshLowMidSlider(nullptr, "dB", "Up Thresh"),
+upwardRatioLowMidSlider(nullptr, ": 1", "Up Ratio")
 {
     using namespace Parameters;
     const auto& parameters = GetParameters();
@@ -949,14 +1742,32 @@ kneeLowMidSlider(nullptr, "", "Knee")
     //threshLowMidSlider.changeParam(&getParamHelper(Names::Threshold_LowMid));
     ratioLowMidSlider.changeParam(&getParamHelper(Names::Ratio_LowMid));
     kneeLowMidSlider.changeParam(&getParamHelper(Names::Knee_LowMid));
+    mixLowMidSlider.changeParam(&getParamHelper(Names::Mix_LowMid));
+    linkLowMidSlider.changeParam(&getParamHelper(Names::Stereo_Link_LowMid));
+    detectorLowMidSlider.changeParam(&getParamHelper(Names::Detector_LowMid));
+    expanderThreshLowMidSlider.changeParam(&getParamHelper(Names::Expander_Threshold_LowMid));
+    expanderRatioLowMidSlider.changeParam(&getParamHelper(Names::Expander_Ratio_LowMid));
+    upwardThreshLowMidSlider.changeParam(&getParamHelper(Names::Upward_Threshold_LowMid));
+    upwardRatioLowMidSlider.changeParam(&getParamHelper(Names::Upward_Ratio_LowMid));
 
     addLabelPairs(attackLowMidSlider.labels, getParamHelper(Names::Attack_LowMid), "ms");
     addLabelPairs(releaseLowMidSlider.labels, getParamHelper(Names::Release_LowMid), "ms");
     //addLabelPairs(threshLowMidSlider.labels, getParamHelper(Names::Threshold_LowMid), "dB");
     addLabelPairs(kneeLowMidSlider.labels, getParamHelper(Names::Knee_LowMid), "");
+    addLabelPairs(mixLowMidSlider.labels, getParamHelper(Names::Mix_LowMid), "%");
+    addLabelPairs(expanderThreshLowMidSlider.labels, getParamHelper(Names::Expander_Threshold_LowMid), "dB");
+    addLabelPairs(upwardThreshLowMidSlider.labels, getParamHelper(Names::Upward_Threshold_LowMid), "dB");
 
     ratioLowMidSlider.labels.add({ 0.f, "1:1" });
     ratioLowMidSlider.labels.add({ 1.f, "30:1" });
+    linkLowMidSlider.labels.add({ 0.f, "Max" });
+    linkLowMidSlider.labels.add({ 1.f, "Off" });
+    detectorLowMidSlider.labels.add({ 0.f, "Peak" });
+    detectorLowMidSlider.labels.add({ 1.f, "RMS" });
+    expanderRatioLowMidSlider.labels.add({ 0.f, "1:1" });
+    expanderRatioLowMidSlider.labels.add({ 1.f, "10:1" });
+    upwardRatioLowMidSlider.labels.add({ 0.f, "1:1" });
+    upwardRatioLowMidSlider.labels.add({ 1.f, "10:1" });
 
     auto makeAttachmentHelper = [&parameters, &apvts = this->apvts](auto& attachment, const auto& name, auto& slider)
     {
@@ -968,12 +1779,26 @@ kneeLowMidSlider(nullptr, "", "Knee")
     makeAttachmentHelper(threshLowMidSliderAttachment, Names::Threshold_LowMid, threshLowMidSlider);
     makeAttachmentHelper(ratioLowMidSliderAttachment, Names::Ratio_LowMid, ratioLowMidSlider);
     makeAttachmentHelper(kneeLowMidSliderAttachment, Names::Knee_LowMid, kneeLowMidSlider);
+    makeAttachmentHelper(mixLowMidSliderAttachment, Names::Mix_LowMid, mixLowMidSlider);
+    makeAttachmentHelper(linkLowMidSliderAttachment, Names::Stereo_Link_LowMid, linkLowMidSlider);
+    makeAttachmentHelper(detectorLowMidSliderAttachment, Names::Detector_LowMid, detectorLowMidSlider);
+    makeAttachmentHelper(expanderThreshLowMidSliderAttachment, Names::Expander_Threshold_LowMid, expanderThreshLowMidSlider);
+    makeAttachmentHelper(expanderRatioLowMidSliderAttachment, Names::Expander_Ratio_LowMid, expanderRatioLowMidSlider);
+    makeAttachmentHelper(upwardThreshLowMidSliderAttachment, Names::Upward_Threshold_LowMid, upwardThreshLowMidSlider);
+    makeAttachmentHelper(upwardRatioLowMidSliderAttachment, Names::Upward_Ratio_LowMid, upwardRatioLowMidSlider);
 
     addAndMakeVisible(attackLowMidSlider);
     addAndMakeVisible(releaseLowMidSlider);
     addAndMakeVisible(threshLowMidSlider);
     addAndMakeVisible(ratioLowMidSlider);
     addAndMakeVisible(kneeLowMidSlider);
+    addAndMakeVisible(mixLowMidSlider);
+    addAndMakeVisible(linkLowMidSlider);
+    addAndMakeVisible(detectorLowMidSlider);
+    addAndMakeVisible(expanderThreshLowMidSlider);
+    addAndMakeVisible(expanderRatioLowMidSlider);
+    addAndMakeVisible(upwardThreshLowMidSlider);
+    addAndMakeVisible(upwardRatioLowMidSlider);
 
     addAndMakeVisible(threshLabel);
     threshLabel.setText("Thres. (dB)", juce::dontSendNotification);
@@ -982,14 +1807,20 @@ kneeLowMidSlider(nullptr, "", "Knee")
     bypassLowMidButton.setName("B");
     soloLowMidButton.setName("S");
     muteLowMidButton.setName("M");
+    autoReleaseLowMidButton.setName("AR");
+    autoMakeupLowMidButton.setName("AM");
 
     addAndMakeVisible(bypassLowMidButton);
     addAndMakeVisible(soloLowMidButton);
     addAndMakeVisible(muteLowMidButton);
+    addAndMakeVisible(autoReleaseLowMidButton);
+    addAndMakeVisible(autoMakeupLowMidButton);
 
     makeAttachmentHelper(muteLowMidAttachment, Names::Mute_LowMid, muteLowMidButton);
     makeAttachmentHelper(soloLowMidAttachment, Names::Solo_LowMid, soloLowMidButton);
     makeAttachmentHelper(bypassLowMidAttachment, Names::Bypassed_LowMid, bypassLowMidButton);
+    makeAttachmentHelper(autoReleaseLowMidAttachment, Names::Auto_Release_LowMid, autoReleaseLowMidButton);
+    makeAttachmentHelper(autoMakeupLowMidAttachment, Names::Auto_Makeup_LowMid, autoMakeupLowMidButton);
 };
 
 void BandLMControls::paint(juce::Graphics& g)
@@ -1027,7 +1858,7 @@ void BandLMControls::resized()
             return flexBox;
         };
 
-        auto bandButtonControlBox = createBandButtonBox({ &muteLowMidButton, &soloLowMidButton, &bypassLowMidButton });
+        auto bandButtonControlBox = createBandButtonBox({ &muteLowMidButton, &soloLowMidButton, &bypassLowMidButton, &autoReleaseLowMidButton, &autoMakeupLowMidButton });
 
         bandButtonControlBox.performLayout(bounds.removeFromTop(30));
 
@@ -1044,7 +1875,9 @@ void BandLMControls::resized()
         flexRow1.items.add(endCap);
         flexRow1.items.add(FlexItem(attackLowMidSlider).withFlex(1.f));
         flexRow1.items.add(FlexItem(releaseLowMidSlider).withFlex(1.f));
-        flexRow1.performLayout(bounds.removeFromTop(windowHeight * 5 / 30).reduced(5));
+        flexRow1.items.add(FlexItem(detectorLowMidSlider).withFlex(1.f));
+        flexRow1.items.add(FlexItem(linkLowMidSlider).withFlex(1.f));
+        flexRow1.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
 
         FlexBox flexRow2;
         flexRow2.flexDirection = FlexBox::Direction::row;
@@ -1052,7 +1885,18 @@ void BandLMControls::resized()
         flexRow2.items.add(endCap);
         flexRow2.items.add(FlexItem(ratioLowMidSlider).withFlex(1.f));
         flexRow2.items.add(FlexItem(kneeLowMidSlider).withFlex(1.f));
-        flexRow2.performLayout(bounds.removeFromTop(windowHeight * 5 / 30).reduced(5));
+        flexRow2.items.add(FlexItem(mixLowMidSlider).withFlex(1.f));
+        flexRow2.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
+
+        FlexBox flexRow3;
+        flexRow3.flexDirection = FlexBox::Direction::row;
+        flexRow3.flexWrap = FlexBox::Wrap::noWrap;
+        flexRow3.items.add(endCap);
+        flexRow3.items.add(FlexItem(expanderThreshLowMidSlider).withFlex(1.f));
+        flexRow3.items.add(FlexItem(expanderRatioLowMidSlider).withFlex(1.f));
+        flexRow3.items.add(FlexItem(upwardThreshLowMidSlider).withFlex(1.f));
+        flexRow3.items.add(FlexItem(upwardRatioLowMidSlider).withFlex(1.f));
+        flexRow3.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
     }
 }
 
@@ -1061,7 +1905,14 @@ attackHighMidSlider(nullptr, "ms", "Attack"),
 releaseHighMidSlider(nullptr, "ms", "Release"),
 //threshHighMidSlider(nullptr, "dB", "Thresh"),
 ratioHighMidSlider(nullptr, ": 1", "Ratio"),
-kneeHighMidSlider(nullptr, "", "Knee")
+kneeHighMidSlider(nullptr, "", "Knee"),
+mixHighMidSlider(nullptr, "%", "Mix"),
+linkHighMidSlider(nullptr, "", "Link"),
+detectorHighMidSlider(nullptr, "", "Detector"),
+expanderThreshHighMidSlider(nullptr, "dB", "Exp. Thresh"),
+expanderRatioHighMidSlider(nullptr, ": 1", "Exp. Ratio"),
+upwardThreshHighMidSlider(nullptr, "dB", "Up Thresh"),
+upwardRatioHighMidSlider(nullptr, ": 1", "Up Ratio")
 {
     using namespace Parameters;
     const auto& parameters = GetParameters();
@@ -1076,14 +1927,32 @@ kneeHighMidSlider(nullptr, "", "Knee")
     //threshHighMidSlider.changeParam(&getParamHelper(Names::Threshold_HighMid));
     ratioHighMidSlider.changeParam(&getParamHelper(Names::Ratio_HighMid));
     kneeHighMidSlider.changeParam(&getParamHelper(Names::Knee_HighMid));
+    mixHighMidSlider.changeParam(&getParamHelper(Names::Mix_HighMid));
+    linkHighMidSlider.changeParam(&getParamHelper(Names::Stereo_Link_HighMid));
+    detectorHighMidSlider.changeParam(&getParamHelper(Names::Detector_HighMid));
+    expanderThreshHighMidSlider.changeParam(&getParamHelper(Names::Expander_Threshold_HighMid));
+    expanderRatioHighMidSlider.changeParam(&getParamHelper(Names::Expander_Ratio_HighMid));
+    upwardThreshHighMidSlider.changeParam(&getParamHelper(Names::Upward_Threshold_HighMid));
+    upwardRatioHighMidSlider.changeParam(&getParamHelper(Names::Upward_Ratio_HighMid));
 
     addLabelPairs(attackHighMidSlider.labels, getParamHelper(Names::Attack_HighMid), "ms");
     addLabelPairs(releaseHighMidSlider.labels, getParamHelper(Names::Release_HighMid), "ms");
     //addLabelPairs(threshHighMidSlider.labels, getParamHelper(Names::Threshold_HighMid), "dB");
     addLabelPairs(kneeHighMidSlider.labels, getParamHelper(Names::Knee_HighMid), "");
+    addLabelPairs(mixHighMidSlider.labels, getParamHelper(Names::Mix_HighMid), "%");
+    addLabelPairs(expanderThreshHighMidSlider.labels, getParamHelper(Names::Expander_Threshold_HighMid), "dB");
+    addLabelPairs(upwardThreshHighMidSlider.labels, getParamHelper(Names::Upward_Threshold_HighMid), "dB");
 
     ratioHighMidSlider.labels.add({ 0.f, "1:1" });
     ratioHighMidSlider.labels.add({ 1.f, "30:1" });
+    linkHighMidSlider.labels.add({ 0.f, "Max" });
+    linkHighMidSlider.labels.add({ 1.f, "Off" });
+    detectorHighMidSlider.labels.add({ 0.f, "Peak" });
+    detectorHighMidSlider.labels.add({ 1.f, "RMS" });
+    expanderRatioHighMidSlider.labels.add({ 0.f, "1:1" });
+    expanderRatioHighMidSlider.labels.add({ 1.f, "10:1" });
+    upwardRatioHighMidSlider.labels.add({ 0.f, "1:1" });
+    upwardRatioHighMidSlider.labels.add({ 1.f, "10:1" });
 
     auto makeAttachmentHelper = [&parameters, &apvts = this->apvts](auto& attachment, const auto& name, auto& slider)
     {
@@ -1095,12 +1964,26 @@ kneeHighMidSlider(nullptr, "", "Knee")
     makeAttachmentHelper(threshHighMidSliderAttachment, Names::Threshold_HighMid, threshHighMidSlider);
     makeAttachmentHelper(ratioHighMidSliderAttachment, Names::Ratio_HighMid, ratioHighMidSlider);
     makeAttachmentHelper(kneeHighMidSliderAttachment, Names::Knee_HighMid, kneeHighMidSlider);
+    makeAttachmentHelper(mixHighMidSliderAttachment, Names::Mix_HighMid, mixHighMidSlider);
+    makeAttachmentHelper(linkHighMidSliderAttachment, Names::Stereo_Link_HighMid, linkHighMidSlider);
+    makeAttachmentHelper(detectorHighMidSliderAttachment, Names::Detector_HighMid, detectorHighMidSlider);
+    makeAttachmentHelper(expanderThreshHighMidSliderAttachment, Names::Expander_Threshold_HighMid, expanderThreshHighMidSlider);
+    makeAttachmentHelper(expanderRatioHighMidSliderAttachment, Names::Expander_Ratio_HighMid, expanderRatioHighMidSlider);
+    makeAttachmentHelper(upwardThreshHighMidSliderAttachment, Names::Upward_Threshold_HighMid, upwardThreshHighMidSlider);
+    makeAttachmentHelper(upwardRatioHighMidSliderAttachment, Names::Upward_Ratio_HighMid, upwardRatioHighMidSlider);
 
     addAndMakeVisible(attackHighMidSlider);
     addAndMakeVisible(releaseHighMidSlider);
     addAndMakeVisible(threshHighMidSlider);
     addAndMakeVisible(ratioHighMidSlider);
     addAndMakeVisible(kneeHighMidSlider);
+    addAndMakeVisible(mixHighMidSlider);
+    addAndMakeVisible(linkHighMidSlider);
+    addAndMakeVisible(detectorHighMidSlider);
+    addAndMakeVisible(expanderThreshHighMidSlider);
+    addAndMakeVisible(expanderRatioHighMidSlider);
+    addAndMakeVisible(upwardThreshHighMidSlider);
+    addAndMakeVisible(upwardRatioHighMidSlider);
 
     addAndMakeVisible(threshLabel);
     threshLabel.setText("Thres. (dB)", juce::dontSendNotification);
@@ -1109,14 +1992,20 @@ kneeHighMidSlider(nullptr, "", "Knee")
     bypassHighMidButton.setName("B");
     soloHighMidButton.setName("S");
     muteHighMidButton.setName("M");
+    autoReleaseHighMidButton.setName("AR");
+    autoMakeupHighMidButton.setName("AM");
 
     addAndMakeVisible(bypassHighMidButton);
     addAndMakeVisible(soloHighMidButton);
     addAndMakeVisible(muteHighMidButton);
+    addAndMakeVisible(autoReleaseHighMidButton);
+    addAndMakeVisible(autoMakeupHighMidButton);
 
     makeAttachmentHelper(muteHighMidAttachment, Names::Mute_HighMid, muteHighMidButton);
     makeAttachmentHelper(soloHighMidAttachment, Names::Solo_HighMid, soloHighMidButton);
     makeAttachmentHelper(bypassHighMidAttachment, Names::Bypassed_HighMid, bypassHighMidButton);
+    makeAttachmentHelper(autoReleaseHighMidAttachment, Names::Auto_Release_HighMid, autoReleaseHighMidButton);
+    makeAttachmentHelper(autoMakeupHighMidAttachment, Names::Auto_Makeup_HighMid, autoMakeupHighMidButton);
 };
 
 void BandHMControls::paint(juce::Graphics& g)
@@ -1154,7 +2043,7 @@ void BandHMControls::resized()
             return flexBox;
         };
 
-        auto bandButtonControlBox = createBandButtonBox({ &muteHighMidButton, &soloHighMidButton, &bypassHighMidButton });
+        auto bandButtonControlBox = createBandButtonBox({ &muteHighMidButton, &soloHighMidButton, &bypassHighMidButton, &autoReleaseHighMidButton, &autoMakeupHighMidButton });
 
         bandButtonControlBox.performLayout(bounds.removeFromTop(30));
 
@@ -1171,7 +2060,9 @@ void BandHMControls::resized()
         flexRow1.items.add(endCap);
         flexRow1.items.add(FlexItem(attackHighMidSlider).withFlex(1.f));
         flexRow1.items.add(FlexItem(releaseHighMidSlider).withFlex(1.f));
-        flexRow1.performLayout(bounds.removeFromTop(windowHeight * 5 / 30).reduced(5));
+        flexRow1.items.add(FlexItem(detectorHighMidSlider).withFlex(1.f));
+        flexRow1.items.add(FlexItem(linkHighMidSlider).withFlex(1.f));
+        flexRow1.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
 
         FlexBox flexRow2;
         flexRow2.flexDirection = FlexBox::Direction::row;
@@ -1179,7 +2070,18 @@ void BandHMControls::resized()
         flexRow2.items.add(endCap);
         flexRow2.items.add(FlexItem(ratioHighMidSlider).withFlex(1.f));
         flexRow2.items.add(FlexItem(kneeHighMidSlider).withFlex(1.f));
-        flexRow2.performLayout(bounds.removeFromTop(windowHeight * 5 / 30).reduced(5));
+        flexRow2.items.add(FlexItem(mixHighMidSlider).withFlex(1.f));
+        flexRow2.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
+
+        FlexBox flexRow3;
+        flexRow3.flexDirection = FlexBox::Direction::row;
+        flexRow3.flexWrap = FlexBox::Wrap::noWrap;
+        flexRow3.items.add(endCap);
+        flexRow3.items.add(FlexItem(expanderThreshHighMidSlider).withFlex(1.f));
+        flexRow3.items.add(FlexItem(expanderRatioHighMidSlider).withFlex(1.f));
+        flexRow3.items.add(FlexItem(upwardThreshHighMidSlider).withFlex(1.f));
+        flexRow3.items.add(FlexItem(upwardRatioHighMidSlider).withFlex(1.f));
+        flexRow3.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
 
 
     }
@@ -1190,7 +2092,14 @@ attackHighSlider(nullptr, "ms", "Attack"),
 releaseHighSlider(nullptr, "ms", "Release"),
 //threshHighSlider(nullptr, "dB", "Thresh"),
 ratioHighSlider(nullptr, ": 1", "Ratio"),
-kneeHighSlider(nullptr, "", "Knee")
+kneeHighSlider(nullptr, "", "Knee"),
+mixHighSlider(nullptr, "%", "Mix"),
+linkHighSlider(nullptr, "", "Link"),
+detectorHighSlider(nullptr, "", "Detector"),
+expanderThreshHighSlider(nullptr, "dB", "Exp. Thresh"),
+expanderRatioHighSlider(nullptr, ": 1", "Exp. Ratio"),
+upwardThreshHighSlider(nullptr, "dB", "Up Thresh"),
+upwardRatioHighSlider(nullptr, ": 1", "Up Ratio")
 {
     using namespace Parameters;
     const auto& parameters = GetParameters();
@@ -1205,14 +2114,32 @@ kneeHighSlider(nullptr, "", "Knee")
     //threshHighSlider.changeParam(&getParamHelper(Names::Threshold_High));
     ratioHighSlider.changeParam(&getParamHelper(Names::Ratio_High));
     kneeHighSlider.changeParam(&getParamHelper(Names::Knee_High));
+    mixHighSlider.changeParam(&getParamHelper(Names::Mix_High));
+    linkHighSlider.changeParam(&getParamHelper(Names::Stereo_Link_High));
+    detectorHighSlider.changeParam(&getParamHelper(Names::Detector_High));
+    expanderThreshHighSlider.changeParam(&getParamHelper(Names::Expander_Threshold_High));
+    expanderRatioHighSlider.changeParam(&getParamHelper(Names::Expander_Ratio_High));
+    upwardThreshHighSlider.changeParam(&getParamHelper(Names::Upward_Threshold_High));
+    upwardRatioHighSlider.changeParam(&getParamHelper(Names::Upward_Ratio_High));
 
     addLabelPairs(attackHighSlider.labels, getParamHelper(Names::Attack_High), "ms");
     addLabelPairs(releaseHighSlider.labels, getParamHelper(Names::Release_High), "ms");
     //addLabelPairs(threshHighSlider.labels, getParamHelper(Names::Threshold_High), "dB");
     addLabelPairs(kneeHighSlider.labels, getParamHelper(Names::Knee_High), "");
+    addLabelPairs(mixHighSlider.labels, getParamHelper(Names::Mix_High), "%");
+    addLabelPairs(expanderThreshHighSlider.labels, getParamHelper(Names::Expander_Threshold_High), "dB");
+    addLabelPairs(upwardThreshHighSlider.labels, getParamHelper(Names::Upward_Threshold_High), "dB");
 
     ratioHighSlider.labels.add({ 0.f, "1:1" });
     ratioHighSlider.labels.add({ 1.f, "30:1" });
+    linkHighSlider.labels.add({ 0.f, "Max" });
+    linkHighSlider.labels.add({ 1.f, "Off" });
+    detectorHighSlider.labels.add({ 0.f, "Peak" });
+    detectorHighSlider.labels.add({ 1.f, "RMS" });
+    expanderRatioHighSlider.labels.add({ 0.f, "1:1" });
+    expanderRatioHighSlider.labels.add({ 1.f, "10:1" });
+    upwardRatioHighSlider.labels.add({ 0.f, "1:1" });
+    upwardRatioHighSlider.labels.add({ 1.f, "10:1" });
 
     auto makeAttachmentHelper = [&parameters, &apvts = this->apvts](auto& attachment, const auto& name, auto& slider)
     {
@@ -1224,12 +2151,26 @@ kneeHighSlider(nullptr, "", "Knee")
     makeAttachmentHelper(threshHighSliderAttachment, Names::Threshold_High, threshHighSlider);
     makeAttachmentHelper(ratioHighSliderAttachment, Names::Ratio_High, ratioHighSlider);
     makeAttachmentHelper(kneeHighSliderAttachment, Names::Knee_High, kneeHighSlider);
+    makeAttachmentHelper(mixHighSliderAttachment, Names::Mix_High, mixHighSlider);
+    makeAttachmentHelper(linkHighSliderAttachment, Names::Stereo_Link_High, linkHighSlider);
+    makeAttachmentHelper(detectorHighSliderAttachment, Names::Detector_High, detectorHighSlider);
+    makeAttachmentHelper(expanderThreshHighSliderAttachment, Names::Expander_Threshold_High, expanderThreshHighSlider);
+    makeAttachmentHelper(expanderRatioHighSliderAttachment, Names::Expander_Ratio_High, expanderRatioHighSlider);
+    makeAttachmentHelper(upwardThreshHighSliderAttachment, Names::Upward_Threshold_High, upwardThreshHighSlider);
+    makeAttachmentHelper(upwardRatioHighSliderAttachment, Names::Upward_Ratio_High, upwardRatioHighSlider);
 
     addAndMakeVisible(attackHighSlider);
     addAndMakeVisible(releaseHighSlider);
     addAndMakeVisible(threshHighSlider);
     addAndMakeVisible(ratioHighSlider);
     addAndMakeVisible(kneeHighSlider);
+    addAndMakeVisible(mixHighSlider);
+    addAndMakeVisible(linkHighSlider);
+    addAndMakeVisible(detectorHighSlider);
+    addAndMakeVisible(expanderThreshHighSlider);
+    addAndMakeVisible(expanderRatioHighSlider);
+    addAndMakeVisible(upwardThreshHighSlider);
+    addAndMakeVisible(upwardRatioHighSlider);
 
     addAndMakeVisible(threshLabel);
     threshLabel.setText("Thres. (dB)", juce::dontSendNotification);
@@ -1238,14 +2179,20 @@ kneeHighSlider(nullptr, "", "Knee")
     bypassHighButton.setName("B");
     soloHighButton.setName("S");
     muteHighButton.setName("M");
+    autoReleaseHighButton.setName("AR");
+    autoMakeupHighButton.setName("AM");
 
     addAndMakeVisible(bypassHighButton);
     addAndMakeVisible(soloHighButton);
     addAndMakeVisible(muteHighButton);
+    addAndMakeVisible(autoReleaseHighButton);
+    addAndMakeVisible(autoMakeupHighButton);
 
     makeAttachmentHelper(muteHighAttachment, Names::Mute_High, muteHighButton);
     makeAttachmentHelper(soloHighAttachment, Names::Solo_High, soloHighButton);
     makeAttachmentHelper(bypassHighAttachment, Names::Bypassed_High, bypassHighButton);
+    makeAttachmentHelper(autoReleaseHighAttachment, Names::Auto_Release_High, autoReleaseHighButton);
+    makeAttachmentHelper(autoMakeupHighAttachment, Names::Auto_Makeup_High, autoMakeupHighButton);
 };
 
 void BandHControls::paint(juce::Graphics& g)
@@ -1283,7 +2230,7 @@ void BandHControls::resized()
             return flexBox;
         };
 
-        auto bandButtonControlBox = createBandButtonBox({ &muteHighButton, &soloHighButton, &bypassHighButton });
+        auto bandButtonControlBox = createBandButtonBox({ &muteHighButton, &soloHighButton, &bypassHighButton, &autoReleaseHighButton, &autoMakeupHighButton });
 
         bandButtonControlBox.performLayout(bounds.removeFromTop(30));
 
@@ -1300,7 +2247,9 @@ void BandHControls::resized()
         flexRow1.items.add(endCap);
         flexRow1.items.add(FlexItem(attackHighSlider).withFlex(1.f));
         flexRow1.items.add(FlexItem(releaseHighSlider).withFlex(1.f));
-        flexRow1.performLayout(bounds.removeFromTop(windowHeight * 5 / 30).reduced(5));
+        flexRow1.items.add(FlexItem(detectorHighSlider).withFlex(1.f));
+        flexRow1.items.add(FlexItem(linkHighSlider).withFlex(1.f));
+        flexRow1.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
 
         FlexBox flexRow2;
         flexRow2.flexDirection = FlexBox::Direction::row;
@@ -1308,7 +2257,18 @@ void BandHControls::resized()
         flexRow2.items.add(endCap);
         flexRow2.items.add(FlexItem(ratioHighSlider).withFlex(1.f));
         flexRow2.items.add(FlexItem(kneeHighSlider).withFlex(1.f));
-        flexRow2.performLayout(bounds.removeFromTop(windowHeight * 5 / 30).reduced(5));
+        flexRow2.items.add(FlexItem(mixHighSlider).withFlex(1.f));
+        flexRow2.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
+
+        FlexBox flexRow3;
+        flexRow3.flexDirection = FlexBox::Direction::row;
+        flexRow3.flexWrap = FlexBox::Wrap::noWrap;
+        flexRow3.items.add(endCap);
+        flexRow3.items.add(FlexItem(expanderThreshHighSlider).withFlex(1.f));
+        flexRow3.items.add(FlexItem(expanderRatioHighSlider).withFlex(1.f));
+        flexRow3.items.add(FlexItem(upwardThreshHighSlider).withFlex(1.f));
+        flexRow3.items.add(FlexItem(upwardRatioHighSlider).withFlex(1.f));
+        flexRow3.performLayout(bounds.removeFromTop(windowHeight * 4 / 30).reduced(5));
     }
 }
 
@@ -1329,12 +2289,20 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
     auto& lowCrossoverParam = getParamHelper(Names::Low_LowMid_Crossover_Freq);
     auto& midCrossoverParam = getParamHelper(Names::LowMid_HighMid_Crossover_Freq);
     auto& highCrossoverParam = getParamHelper(Names::HighMid_High_Crossover_Freq);
+    auto& globalMixParam = getParamHelper(Names::Global_Mix);
+    auto& limiterCeilingParam = getParamHelper(Names::Limiter_Ceiling);
+    auto& limiterReleaseParam = getParamHelper(Names::Limiter_Release);
+    auto& crossoverSlopeParam = getParamHelper(Names::Crossover_Slope);
 
     inputGainSlider = std::make_unique<RSWL>(&inputGainParam, "dB", "Input Gain");
     outputGainSlider = std::make_unique<RSWL>(&outputGainParam, "dB", "Output Gain");
     lowCrossoverSlider = std::make_unique<RSWL>(&lowCrossoverParam, "Hz", "Low Crossover");
     midCrossoverSlider = std::make_unique<RSWL>(&midCrossoverParam, "Hz", "Mid Crossover");
     highCrossoverSlider = std::make_unique<RSWL>(&highCrossoverParam, "Hz", "High Crossover");
+    globalMixSlider = std::make_unique<RSWL>(&globalMixParam, "%", "Mix");
+    limiterCeilingSlider = std::make_unique<RSWL>(&limiterCeilingParam, "dB", "Ceiling");
+    limiterReleaseSlider = std::make_unique<RSWL>(&limiterReleaseParam, "ms", "Lim. Release");
+    crossoverSlopeSlider = std::make_unique<RSWL>(&crossoverSlopeParam, "", "Slope");
 
     auto makeAttachmentHelper = [&parameters, &apvts](auto& attachment, const auto& name, auto& slider)
     {
@@ -1346,18 +2314,35 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
     makeAttachmentHelper(lowCrossoverSliderAttachment, Names::Low_LowMid_Crossover_Freq, *lowCrossoverSlider);
     makeAttachmentHelper(midCrossoverSliderAttachment, Names::LowMid_HighMid_Crossover_Freq, *midCrossoverSlider);
     makeAttachmentHelper(highCrossoverSliderAttachment, Names::HighMid_High_Crossover_Freq, *highCrossoverSlider);
+    makeAttachmentHelper(globalMixSliderAttachment, Names::Global_Mix, *globalMixSlider);
+    makeAttachmentHelper(limiterCeilingSliderAttachment, Names::Limiter_Ceiling, *limiterCeilingSlider);
+    makeAttachmentHelper(limiterReleaseSliderAttachment, Names::Limiter_Release, *limiterReleaseSlider);
+    makeAttachmentHelper(crossoverSlopeSliderAttachment, Names::Crossover_Slope, *crossoverSlopeSlider);
+    makeAttachmentHelper(limiterButtonAttachment, Names::Limiter_Enabled, limiterButton);
 
     addLabelPairs(inputGainSlider->labels, inputGainParam, "dB");
     addLabelPairs(outputGainSlider->labels, outputGainParam, "dB");
     addLabelPairs(lowCrossoverSlider->labels, lowCrossoverParam, "Hz");
     addLabelPairs(midCrossoverSlider->labels, midCrossoverParam, "Hz");
     addLabelPairs(highCrossoverSlider->labels, highCrossoverParam, "Hz");
+    addLabelPairs(globalMixSlider->labels, globalMixParam, "%");
+    addLabelPairs(limiterCeilingSlider->labels, limiterCeilingParam, "dB");
+    addLabelPairs(limiterReleaseSlider->labels, limiterReleaseParam, "ms");
+    crossoverSlopeSlider->labels.add({ 0.f, "12" });
+    crossoverSlopeSlider->labels.add({ 1.f, "48" });
 
     addAndMakeVisible(*inputGainSlider);
     addAndMakeVisible(*outputGainSlider);
     addAndMakeVisible(*lowCrossoverSlider);
     addAndMakeVisible(*midCrossoverSlider);
     addAndMakeVisible(*highCrossoverSlider);
+    addAndMakeVisible(*globalMixSlider);
+    addAndMakeVisible(*limiterCeilingSlider);
+    addAndMakeVisible(*limiterReleaseSlider);
+    addAndMakeVisible(*crossoverSlopeSlider);
+
+    limiterButton.setName("Limit");
+    addAndMakeVisible(limiterButton);
 }
 
 void GlobalControls::paint(juce::Graphics& g)
@@ -1393,7 +2378,16 @@ void GlobalControls::resized()
     flexBox.items.add(spacer);
     flexBox.items.add(FlexItem(*highCrossoverSlider).withFlex(1.f));
     flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(*crossoverSlopeSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
     flexBox.items.add(FlexItem(*outputGainSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(*globalMixSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(limiterButton).withWidth(50).withHeight(30));
+    flexBox.items.add(FlexItem(*limiterCeilingSlider).withFlex(1.f));
+    flexBox.items.add(spacer);
+    flexBox.items.add(FlexItem(*limiterReleaseSlider).withFlex(1.f));
 
     flexBox.performLayout(bounds);
 }
@@ -1406,6 +2400,7 @@ Projekt_zespoowy_2022AudioProcessorEditor::Projekt_zespoowy_2022AudioProcessorEd
     // editor's size to whatever you need it to be.
     setLookAndFeel(&lnf);
     addAndMakeVisible(analyzer);
+    addAndMakeVisible(gainReductionHistory);
 
     addAndMakeVisible(globalControls);
     addAndMakeVisible(bandLowControls);
@@ -1415,7 +2410,12 @@ Projekt_zespoowy_2022AudioProcessorEditor::Projekt_zespoowy_2022AudioProcessorEd
 
     setSize (windowWidth, windowHeight);
 
-    startTimerHz(60);
+    //mierniki redukcji: szybkie narastanie, wolne opadanie
+    analyzer.setGainReductionBallistics(10.f, 300.f, static_cast<float>(meterRefreshRateHz));
+    //szczyt redukcji: 1,5 s trzymania, potem 12 dB/s
+    analyzer.setGainReductionPeakHold(1500.f, 12.f, static_cast<float>(meterRefreshRateHz));
+
+    startTimerHz(meterRefreshRateHz);
 }
 
 Projekt_zespoowy_2022AudioProcessorEditor::~Projekt_zespoowy_2022AudioProcessorEditor()
@@ -1438,7 +2438,9 @@ void Projekt_zespoowy_2022AudioProcessorEditor::resized()
     // subcomponents in your editor..
     auto bounds = getLocalBounds();
     globalControls.setBounds(bounds.removeFromTop(windowHeight / 6));
-    analyzer.setBounds(bounds.removeFromTop(windowHeight / 3));
+    auto analyzerArea = bounds.removeFromTop(windowHeight / 3);
+    gainReductionHistory.setBounds(analyzerArea.removeFromBottom(windowHeight / 12));
+    analyzer.setBounds(analyzerArea);
     bandLowControls.setBounds(bounds.removeFromLeft(windowWidth / 4));
     bandLowMidControls.setBounds(bounds.removeFromLeft(windowWidth / 4));
     bandHighMidControls.setBounds(bounds.removeFromLeft(windowWidth / 4));
@@ -1447,17 +2449,9 @@ void Projekt_zespoowy_2022AudioProcessorEditor::resized()
 
 void Projekt_zespoowy_2022AudioProcessorEditor::timerCallback()
 {
-    std::vector<float> values
-    {
-        audioProcessor.lowComp.getRMSInputLevelDb(),
-        audioProcessor.lowComp.getRMSOutputLevelDb(),
-        audioProcessor.lowMidComp.getRMSInputLevelDb(),
-        audioProcessor.lowMidComp.getRMSOutputLevelDb(),
-        audioProcessor.highMidComp.getRMSInputLevelDb(),
-        audioProcessor.highMidComp.getRMSOutputLevelDb(),
-        audioProcessor.highComp.getRMSInputLevelDb(),
-        audioProcessor.highComp.getRMSOutputLevelDb(),
-    };
-
-    analyzer.update(values);
+    //najnowszy komplet mierników z wątku audio, bez alokacji
+    //balistyka liczona co tick, także gdy nie przyszedł nowy blok
+    audioProcessor.meterSnapshots.pull(meterSnapshot);
+    analyzer.update(meterSnapshot);
+    gainReductionHistory.update();
 }
\ No newline at end of file
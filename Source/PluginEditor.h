@@ -10,189 +10,714 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "FFTEngine.h"
 
-enum FFTOrder
-{
-    order2048 = 11,
-    order4096 = 12,
-    order8192 = 13
-};
+#include <deque>
 
+//widma lewego i prawego kanału z jednej zespolonej FFT (l + i r) - ramki zawsze wyrównane w czasie
 template<typename BlockType>
 struct FFTDataGenerator
 {
+    static constexpr int numChannels = 2;
+
     /**
-     produces the FFT data from an audio buffer.
+     produces the FFT data from the frames written to getFrameBuffer(0/1) (getFFTSize() samples each).
      */
-    void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
+    void produceFFTDataForRendering(const float negativeInfinity)
     {
         const auto fftSize = getFFTSize();
 
-        fftData.assign(fftData.size(), 0);
-        auto* readIndex = audioData.getReadPointer(0);
-        std::copy(readIndex, readIndex + fftSize, fftData.begin());
-
         // first apply a windowing function to our data
-        window->multiplyWithWindowingTable(fftData.data(), fftSize);       // [1]
+        for (auto& channelData : fftData)
+            juce::FloatVectorOperations::multiply(channelData.data(), window->data(), fftSize);       // [1]
 
         // then render our FFT data..
-        forwardFFT->performFrequencyOnlyForwardTransform(fftData.data());  // [2]
-
-        int numBins = (int)fftSize / 2;
-
-        //normalize the fft values.
-        for (int i = 0; i < numBins; ++i)
-        {
-            auto v = fftData[i];
-            //            fftData[i] /= (float) numBins;
-            if (!std::isinf(v) && !std::isnan(v))
-            {
-                v /= float(numBins);
-            }
-            else
-            {
-                v = 0.f;
-            }
-            fftData[i] = v;
-        }
-
-        //convert them to decibels
-        for (int i = 0; i < numBins; ++i)
-        {
-            fftData[i] = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
-        }
+        plan->performStereoPowerSpectrumTransform(fftData[0].data(), fftData[1].data(), scratch.data());  // [2]
 
-        fftDataFifo.push(fftData);
+        //normalizacja (|X| / numBins), dB i próg negativeInfinity w jednym przebiegu na kanał
+        const auto numBins = fftSize / 2;
+        const auto powerScale = 1.f / float(numBins * numBins);
+        for (auto& channelData : fftData)
+            FastDecibels::powerToDecibels(channelData.data(), numBins, powerScale, negativeInfinity);
     }
 
-    void changeOrder(FFTOrder newOrder)
+    void changeOrder(FFTOrder newOrder,
+        FFTPlanCache::WindowType windowType = juce::dsp::WindowingFunction<float>::blackmanHarris,
+        FFTEngine engine = defaultFFTEngine)
     {
-        //when you change order, recreate the window, forwardFFT, fifo, fftData
-        //also reset the fifoIndex
-        //things that need recreating should be created on the heap via std::make_unique<>
+        //okno i plan własnej FFT ze wspólnej pamięci podręcznej, lokalnie bufory robocze
+        //(i plan JUCE - generator używa go tylko z wątku analizującego jego klienta)
 
         order = newOrder;
-        auto fftSize = getFFTSize();
-
-        forwardFFT = std::make_unique<juce::dsp::FFT>(order);
-        window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
+        plan = planCache->getPlan(order, engine);
+        window = planCache->getWindow(order, windowType);
 
-        fftData.clear();
-        fftData.resize(fftSize * 2, 0);
-
-        fftDataFifo.prepare(fftData.size());
+        for (auto& channelData : fftData)
+        {
+            channelData.clear();
+            channelData.resize(getFFTSize() * 2, 0);
+        }
+        scratch.assign(getFFTSize() * 2, 0);
     }
     //==============================================================================
     int getFFTSize() const { return 1 << order; }
-    int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
     //==============================================================================
-    bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
+    float* getFrameBuffer(int channel) { return fftData[(size_t)channel].data(); }
+    const BlockType& getFFTData(int channel) const { return fftData[(size_t)channel]; }
 private:
     FFTOrder order;
-    BlockType fftData;
-    std::unique_ptr<juce::dsp::FFT> forwardFFT;
-    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+    std::array<BlockType, numChannels> fftData;
+    BlockType scratch;
+    std::shared_ptr<const FFTPlan> plan;
+    std::shared_ptr<const std::vector<float>> window;
+    juce::SharedResourcePointer<FFTPlanCache> planCache;
+};
 
-    Fifo<BlockType> fftDataFifo;
+//widmo jednego pasma analizy wielorozdzielczej; kolumny poniżej upperFrequency biorą dane z tego pasma
+struct SpectrumBand
+{
+    const float* data = nullptr;
+    int fftSize = 0;
+    float binWidth = 0.f;
+    float upperFrequency = std::numeric_limits<float>::max();
 };
 
+//redukcja widma do jednej wartości na kolumnę pikseli; mapa bin -> kolumna liczona tylko przy zmianie szerokości lub pasm (rząd FFT, częstotliwość próbkowania)
 template<typename PathType>
 struct AnalyzerPathGenerator
 {
+    static constexpr int maxBands = 2;
+
+    enum class ColumnReduction
+    {
+        max,
+        mean
+    };
+
+    void setColumnReduction(ColumnReduction newReduction) { reduction = newReduction; }
+
     /*
-     converts 'renderData[]' into a juce::Path
+     converts 'bands[]' (ordered by upperFrequency, the last one covers the rest) into the averaged
+     trace 'p' and the peak-hold trace 'peakPath' (reusing their storage)
+     'averaging' - share of the previous column level kept (0 = no averaging)
+     'peakDecayDb' - how far the held peaks fall since the previous frame
      */
-    void generatePath(const std::vector<float>& renderData,
+    void generatePath(const SpectrumBand* bands,
+        int numBands,
         juce::Rectangle<float> fftBounds,
-        int fftSize,
-        float binWidth,
-        float negativeInfinity)
+        float negativeInfinity,
+        float averaging,
+        float peakDecayDb,
+        PathType& p,
+        PathType& peakPath)
     {
         auto top = fftBounds.getY();
         auto bottom = fftBounds.getBottom();
-        auto width = fftBounds.getWidth();
 
-        int numBins = (int)fftSize / 2;
+        updateColumnMap((int)fftBounds.getWidth(), bands, juce::jlimit(1, maxBands, numBands));
+
+        p.clear();
+        peakPath.clear();
+
+        const auto numColumns = (int)columns.size();
+        if (numColumns == 0)
+            return;
+
+        auto* levels = columnLevels.data();
 
-        PathType p;
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
+        for (int x = 0; x < numColumns; ++x)
+        {
+            const auto& column = columns[(size_t)x];
+            const auto* data = bands[column.band].data;
+
+            if (column.numBins == 0)
+            {
+                //kolumna między dwoma binami (niskie częstotliwości) - interpolacja
+                auto a = data[column.firstBin];
+                auto b = data[column.firstBin + 1];
+                levels[x] = a + column.fraction * (b - a);
+            }
+            else if (reduction == ColumnReduction::max)
+            {
+                levels[x] = juce::FloatVectorOperations::findMaximum(data + column.firstBin, column.numBins);
+            }
+            else
+            {
+                levels[x] = FastDecibels::powerMeanDecibels(data + column.firstBin, column.numBins, negativeInfinity);
+            }
+        }
+
+        //uśrednianie i opadający szczyt w dB w jednym przebiegu; po przebudowie mapy oba ślady od bieżącej ramki
+        if (averagedLevels.size() == columns.size())
+        {
+            SpectrumBallistics::process(levels, averagedLevels.data(), peakLevels.data(), numColumns, averaging, peakDecayDb);
+        }
+        else
+        {
+            averagedLevels.assign(levels, levels + numColumns);
+            peakLevels.assign(levels, levels + numColumns);
+        }
 
-        auto map = [bottom, top, negativeInfinity](float v)
+        //oba ślady z tych samych danych: jmap(v, negativeInfinity, 12, bottom, top) dla wszystkich kolumn naraz
+        const auto scale = (top - bottom) / (12.f - negativeInfinity);
+        auto buildPath = [levels, numColumns, scale, negativeInfinity, bottom](const std::vector<float>& source, PathType& path)
         {
-            return juce::jmap(v,
-                negativeInfinity, 12.f,
-                bottom, top);
+            juce::FloatVectorOperations::copy(levels, source.data(), numColumns);
+            juce::FloatVectorOperations::add(levels, -negativeInfinity, numColumns);
+            juce::FloatVectorOperations::multiply(levels, scale, numColumns);
+            juce::FloatVectorOperations::add(levels, bottom, numColumns);
+
+            path.preallocateSpace(3 * (numColumns + 1));
+            path.startNewSubPath(0, levels[0]);
+
+            for (int x = 1; x < numColumns; ++x)
+                path.lineTo((float)x, levels[x]);
         };
 
-        auto y = map(renderData[0]);
+        buildPath(averagedLevels, p);
+        buildPath(peakLevels, peakPath);
+    }
 
-        //        jassert( !std::isnan(y) && !std::isinf(y) );
-        if (std::isnan(y) || std::isinf(y))
-            y = bottom;
+private:
+    struct Column
+    {
+        int band = 0;
+        int firstBin = 0;
+        int numBins = 0;
+        float fraction = 0.f;
+    };
 
-        p.startNewSubPath(0, y);
+    void updateColumnMap(int width, const SpectrumBand* bands, int numBands)
+    {
+        auto mapChanged = width != mapWidth || numBands != mapNumBands;
+        for (int b = 0; b < numBands; ++b)
+        {
+            const auto& key = mapBands[(size_t)b];
+            mapChanged = mapChanged
+                || bands[b].fftSize != key.fftSize
+                || bands[b].binWidth != key.binWidth
+                || bands[b].upperFrequency != key.upperFrequency;
+            mapBands[(size_t)b] = bands[b];
+        }
+
+        if (!mapChanged)
+            return;
+
+        mapWidth = width;
+        mapNumBands = numBands;
+
+        columns.clear();
 
-        const int pathResolution = 4; //you can draw line-to's every 'pathResolution' pixels.
+        if (width <= 0)
+            return;
 
-        for (int binNum = 1; binNum < numBins; binNum += pathResolution)
+        auto frequencyAt = [width](float x)
         {
-            y = map(renderData[binNum]);
+            return juce::mapToLog10(x / (float)width, 20.f, 20000.f);
+        };
+
+        columns.reserve((size_t)width);
 
-            //            jassert( !std::isnan(y) && !std::isinf(y) );
+        for (int x = 0; x < width; ++x)
+        {
+            //pasmo wybierane po środku kolumny
+            auto band = 0;
+            while (band < numBands - 1 && frequencyAt((float)x + 0.5f) >= bands[band].upperFrequency)
+                ++band;
 
-            if (!std::isnan(y) && !std::isinf(y))
+            const int numBins = bands[band].fftSize / 2;
+            const auto binWidth = bands[band].binWidth;
+            if (numBins < 2 || binWidth <= 0.f)
+                break;
+
+            auto binAt = [&frequencyAt, binWidth](float position) { return frequencyAt(position) / binWidth; };
+
+            const auto lo = binAt((float)x);
+            const auto hi = binAt((float)(x + 1));
+
+            //powyżej Nyquista nie ma już czego rysować
+            if (lo >= (float)(numBins - 1))
+                break;
+
+            Column column;
+            column.band = band;
+            const auto first = juce::jmax(1, (int)std::ceil(lo));
+            const auto last = juce::jmin(numBins - 1, (int)std::ceil(hi) - 1);
+
+            if (last >= first)
+            {
+                column.firstBin = first;
+                column.numBins = last - first + 1;
+            }
+            else
             {
-                auto binFreq = binNum * binWidth;
-                auto normalizedBinX = juce::mapFromLog10(binFreq, 20.f, 20000.f);
-                int binX = std::floor(normalizedBinX * width);
-                p.lineTo(binX, y);
+                const auto centre = binAt((float)x + 0.5f);
+                column.firstBin = juce::jlimit(0, numBins - 2, (int)std::floor(centre));
+                column.fraction = juce::jlimit(0.f, 1.f, centre - (float)column.firstBin);
             }
+
+            columns.push_back(column);
+        }
+
+        columnLevels.resize(columns.size());
+        averagedLevels.clear();
+    }
+
+    ColumnReduction reduction = ColumnReduction::max;
+
+    std::vector<Column> columns;
+    std::vector<float> columnLevels;
+    std::vector<float> averagedLevels;
+    std::vector<float> peakLevels;
+
+    int mapWidth = -1;
+    int mapNumBands = 0;
+    std::array<SpectrumBand, maxBands> mapBands;
+};
+
+//decymacja dolnego pasma dla analizy wielorozdzielczej: filtr FIR (okienkowany sinc), liczony tylko dla co factor-tej próbki
+struct AnalyzerDecimator
+{
+    void prepare(int newFactor)
+    {
+        factor = juce::jmax(1, newFactor);
+        const auto numTaps = tapsPerPhase * factor;
+
+        //granica na Nyquiście po decymacji: odbicia z pasma przejściowego trafiają powyżej zwrotnicy niskiego pasma
+        //(wyświetlane jest tylko dolne 1/4 pasma), wzmocnienie 1 w paśmie
+        coefficients.resize((size_t)numTaps);
+        const auto cutoff = 0.5f / (float)factor;
+        const auto centre = 0.5f * (float)(numTaps - 1);
+        auto sum = 0.f;
+        for (int i = 0; i < numTaps; ++i)
+        {
+            const auto t = (float)i - centre;
+            const auto sinc = t == 0.f ? 2.f * cutoff
+                                       : std::sin(juce::MathConstants<float>::twoPi * cutoff * t) / (juce::MathConstants<float>::pi * t);
+            const auto phase = juce::MathConstants<float>::twoPi * (float)i / (float)(numTaps - 1);
+            const auto window = 0.42f - 0.5f * std::cos(phase) + 0.08f * std::cos(2.f * phase);
+            coefficients[(size_t)i] = sinc * window;
+            sum += coefficients[(size_t)i];
         }
+        juce::FloatVectorOperations::multiply(coefficients.data(), 1.f / sum, numTaps);
 
-        pathFifo.push(p);
+        //historia zapisana podwójnie - okno filtru zawsze ciągłe w pamięci
+        history.assign((size_t)numTaps * 2, 0.f);
+        reset();
     }
 
-    int getNumPathsAvailable() const
+    void reset()
     {
-        return pathFifo.getNumAvailableForReading();
+        std::fill(history.begin(), history.end(), 0.f);
+        writeIndex = 0;
+        phase = 0;
     }
 
-    bool getPath(PathType& path)
+    int getFactor() const { return factor; }
+
+    //zwraca liczbę próbek zapisanych do out (najwyżej numSamples / factor + 1)
+    int process(const float* in, int numSamples, float* out)
     {
-        return pathFifo.pull(path);
+        const auto numTaps = (int)coefficients.size();
+        auto numOut = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            history[(size_t)writeIndex] = history[(size_t)(writeIndex + numTaps)] = in[i];
+            if (++writeIndex == numTaps)
+                writeIndex = 0;
+
+            if (++phase < factor)
+                continue;
+
+            phase = 0;
+            const auto* window = history.data() + writeIndex;
+            auto acc = 0.f;
+            for (int k = 0; k < numTaps; ++k)
+                acc += window[k] * coefficients[(size_t)k];
+            out[numOut++] = acc;
+        }
+
+        return numOut;
     }
 private:
-    Fifo<PathType> pathFifo;
+    static constexpr int tapsPerPhase = 16;
+
+    std::vector<float> coefficients;
+    std::vector<float> history;
+    int writeIndex = 0;
+    int phase = 0;
+    int factor = 1;
+};
+
+//harmonogram STFT: kołowa historia próbek i ramka co hopSize próbek, niezależnie od rozmiaru bloku hosta
+//ramki, których ekran i tak by nie pokazał, nie są liczone - najwyżej jedna na odczyt
+//wspólna pozycja zapisu dla wszystkich kanałów - ramki kanałów wyrównane w czasie
+struct StftScheduler
+{
+    void prepare(int newNumChannels, int newFftSize, int newHopSize)
+    {
+        fftSize = newFftSize;
+        history.resize((size_t)newNumChannels);
+        for (auto& channelHistory : history)
+            channelHistory.assign((size_t)juce::nextPowerOfTwo(fftSize * 2), 0.f);
+        mask = getCapacity() - 1;
+        writePosition = 0;
+        pendingSamples = 0;
+        setHopSize(newHopSize);
+    }
+
+    void setHopSize(int newHopSize) { hopSize = juce::jlimit(1, fftSize, newHopSize); }
+    //zakładka 0..1 (0.75 = ramka co 1/4 długości FFT)
+    void setOverlap(float overlap) { setHopSize(juce::roundToInt((float)fftSize * (1.f - juce::jlimit(0.f, 0.95f, overlap)))); }
+
+    int getHopSize() const { return hopSize; }
+    int getFFTSize() const { return fftSize; }
+    int getCapacity() const { return history.empty() ? 0 : (int)history.front().size(); }
+
+    //zapis numSamples (<= getCapacity()) próbek kanału od pozycji writePosition + offset, bez przesuwania
+    void write(int channel, const float* data, int numSamples, int offset)
+    {
+        jassert(numSamples <= getCapacity());
+        auto& channelHistory = history[(size_t)channel];
+        const auto start = (writePosition + offset) & mask;
+        const auto n1 = juce::jmin(numSamples, getCapacity() - start);
+        std::copy(data, data + n1, channelHistory.begin() + start);
+        std::copy(data + n1, data + numSamples, channelHistory.begin());
+    }
+
+    //zatwierdza numSamples próbek zapisanych we wszystkich kanałach
+    void advance(int numSamples)
+    {
+        pendingSamples += numSamples;
+        writePosition = (writePosition + numSamples) & mask;
+    }
+
+    bool isFrameDue() const { return pendingSamples >= hopSize; }
+
+    //ostatnia ramka na siatce hopSize dla każdego kanału, w kolejności czasowej; ramki pośrednie są pomijane
+    //zwraca liczbę próbek od poprzedniej ramki
+    int readFrame(float* const* destinations)
+    {
+        jassert(isFrameDue());
+        const auto skip = pendingSamples % hopSize;
+        const auto elapsed = pendingSamples - skip;
+        pendingSamples = skip;
+
+        const auto capacity = getCapacity();
+        const auto start = (writePosition - skip - fftSize + 2 * capacity) & mask;
+        const auto n1 = juce::jmin(fftSize, capacity - start);
+        for (size_t ch = 0; ch < history.size(); ++ch)
+        {
+            const auto& channelHistory = history[ch];
+            std::copy(channelHistory.begin() + start, channelHistory.begin() + start + n1, destinations[ch]);
+            std::copy(channelHistory.begin(), channelHistory.begin() + (fftSize - n1), destinations[ch] + n1);
+        }
+
+        return elapsed;
+    }
+private:
+    std::vector<std::vector<float>> history;
+    int mask = 0;
+    int writePosition = 0;
+    int pendingSamples = 0;
+    int fftSize = 0;
+    int hopSize = 1;
+};
+
+//jakość analizy: zakładka ramek (hop) i czas uśredniania; rząd FFT i okno wybierane osobno
+enum class AnalyzerQuality
+{
+    fast,
+    normal,
+    smooth
+};
+
+struct AnalyzerSettings
+{
+    FFTOrder order = FFTOrder::order2048;
+    FFTPlanCache::WindowType window = juce::dsp::WindowingFunction<float>::blackmanHarris;
+    AnalyzerQuality quality = AnalyzerQuality::normal;
+
+    float getOverlap() const
+    {
+        switch (quality)
+        {
+            case AnalyzerQuality::fast: return 0.5f;
+            case AnalyzerQuality::smooth: return 0.875f;
+            default: return 0.75f;
+        }
+    }
+
+    float getAveragingMs() const
+    {
+        switch (quality)
+        {
+            case AnalyzerQuality::fast: return 0.f;
+            case AnalyzerQuality::smooth: return 300.f;
+            default: return 100.f;
+        }
+    }
+
+    bool operator==(const AnalyzerSettings& other) const
+    {
+        return order == other.order && window == other.window && quality == other.quality;
+    }
+    bool operator!=(const AnalyzerSettings& other) const { return !(*this == other); }
+};
+
+//wszystko, co zależy od rzędu FFT i okna; budowane na wątku puli analizy i podmieniane w PathProducer w całości
+struct AnalysisEngine
+{
+    static constexpr int numChannels = FFTDataGenerator<std::vector<float>>::numChannels;
+
+    explicit AnalysisEngine(const AnalyzerSettings& s) :
+        settings(s)
+    {
+        fftDataGenerator.changeOrder(settings.order, settings.window);
+        lowFFTDataGenerator.changeOrder(settings.order, settings.window);
+
+        const auto fftSize = fftDataGenerator.getFFTSize();
+        stft.prepare(numChannels, fftSize, fftSize);
+        stft.setOverlap(settings.getOverlap());
+        prepareLowBand();
+    }
+
+    //niskie pasmo odświeżane rzadziej: ramka co 1/8 FFT, czyli co fftSize * factor / 8 próbek wejścia
+    void prepareLowBand()
+    {
+        lowStft.prepare(numChannels, lowFFTDataGenerator.getFFTSize(), lowFFTDataGenerator.getFFTSize() / 8);
+    }
+
+    const AnalyzerSettings settings;
+
+    StftScheduler stft;
+    FFTDataGenerator<std::vector<float>> fftDataGenerator;
+
+    StftScheduler lowStft;
+    FFTDataGenerator<std::vector<float>> lowFFTDataGenerator;
 };
 
+//analiza obu kanałów naraz (jedna FFT na ramkę stereo)
+//wielorozdzielczo: ta sama FFT na sygnale pełnym i zdecymowanym (niskie pasmo, factor razy węższe biny), sklejane na osi log
 struct PathProducer
 {
-    PathProducer(SingleChannelSampleFifo<Projekt_zespoowy_2022AudioProcessor::BlockType>& scsf) :
-        leftChannelFifo(&scsf)
+    using ChannelFifo = SingleChannelSampleFifo<Projekt_zespoowy_2022AudioProcessor::BlockType>;
+
+    PathProducer(ChannelFifo& left, ChannelFifo& right) :
+        channelFifos{ &left, &right },
+        engine(std::make_unique<AnalysisEngine>(AnalyzerSettings()))
     {
-        leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
-        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
     }
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
+    //zwraca true, gdy powstały nowe ścieżki
+    bool process(juce::Rectangle<float> fftBounds, double sampleRate);
+    const juce::Path& getPath(int channel) const { return channelPaths[(size_t)channel]; }
+    const juce::Path& getPeakPath(int channel) const { return peakPaths[(size_t)channel]; }
 
     void updateNegativeInfinity(float nf) {
         negativeInfinity = nf;
     }
+
+    //tylko gdy klient nie jest w puli analizy (SpectrumAnalysisService::removeClient)
+    void setSource(ChannelFifo& left, ChannelFifo& right) { channelFifos = { &left, &right }; }
+
+    const AnalyzerSettings& getSettings() const { return engine->settings; }
+    //wątek analizy; nowy silnik zaczyna od pustej historii, stare ścieżki zostają do pierwszej ramki
+    void setEngine(std::unique_ptr<AnalysisEngine> newEngine);
+
+    void setMultiResolution(bool shouldUseLowBand) { multiResolution = shouldUseLowBand; }
 private:
-    SingleChannelSampleFifo<Projekt_zespoowy_2022AudioProcessor::BlockType>* leftChannelFifo;
+    static constexpr int numChannels = AnalysisEngine::numChannels;
+    //niskie pasmo do 1/4 Nyquista sygnału zdecymowanego (~750 Hz przy 48 kHz)
+    static constexpr float lowBandCrossover = 0.125f;
+    //decymacja w kawałkach - bufor niezależny od rzędu FFT
+    static constexpr int decimationChunk = 1024;
+    //opadanie trzymanych szczytów
+    static constexpr float peakDecayDbPerSecond = 20.f;
+
+    void prepareLowBand(int factor);
+    //tylko z blokadami odczytu obu FIFO
+    void readFifos(bool useLowBand);
+    void writeLowBand(int channel, const float* data, int numSamples);
 
-    juce::AudioBuffer<float> monoBuffer;
+    std::array<ChannelFifo*, numChannels> channelFifos;
 
-    FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
+    std::unique_ptr<AnalysisEngine> engine;
 
-    AnalyzerPathGenerator<juce::Path> pathProducer;
+    bool multiResolution = true;
+    bool hasLowBandFrame = false;
+    std::array<AnalyzerDecimator, numChannels> decimators;
+    std::vector<float> decimated;
+    int numDecimated = 0;
 
-    juce::Path leftChannelFFTPath;
+    std::array<AnalyzerPathGenerator<juce::Path>, numChannels> pathGenerators;
+
+    std::array<juce::Path, numChannels> channelPaths;
+    std::array<juce::Path, numChannels> peakPaths;
 
     float negativeInfinity{ -48.f };
 };
 
+//parametry rysowania przekazywane z wątku GUI do wątku analizy
+struct AnalyzerGeometry
+{
+    juce::Rectangle<float> fftBounds;
+    double sampleRate = 0.0;
+    float negativeInfinity = -48.f;
+};
+
+//gotowe ścieżki obu kanałów (uśrednione i szczytowe), publikowane przez wątek analizy
+struct AnalyzerFrame
+{
+    juce::Path left, right;
+    juce::Path leftPeak, rightPeak;
+};
+
+//analiza jednego analizatora: FFT, dB i budowa ścieżek wykonywane przez wspólną pulę wątków
+//wątek GUI tylko podaje geometrię i odbiera najnowszą ramkę (potrójne bufory, bez blokad)
+struct SpectrumAnalysisClient
+{
+    explicit SpectrumAnalysisClient(PathProducer& producer) :
+        pathProducer(producer)
+    {
+    }
+
+    //wątek puli - nigdy równolegle dla tego samego klienta
+    void analyse();
+
+    //wątek GUI
+    void setGeometry(const AnalyzerGeometry& g) { geometry.push(g); }
+    bool getLatestFrame(AnalyzerFrame& frame) { return frames.pull(frame); }
+    void setEnabled(bool shouldAnalyse) { enabled.store(shouldAnalyse); }
+    void setShowing(bool isShowing) { showing.store(isShowing); }
+    void setFocused(bool isFocused) { focused.store(isFocused); }
+    //nowy plan, okno i bufory budowane przy następnym wywołaniu analyse(), poza wątkiem GUI
+    void setSettings(const AnalyzerSettings& s) { settings.push(s); }
+
+    bool wantsAnalysis() const { return enabled.load() && showing.load(); }
+    bool isFocused() const { return focused.load(); }
+private:
+    friend struct SpectrumAnalysisService;
+
+    PathProducer& pathProducer;
+
+    TripleBuffer<AnalyzerGeometry> geometry;
+    TripleBuffer<AnalyzerFrame> frames;
+    TripleBuffer<AnalyzerSettings> settings;
+    AnalyzerGeometry current;
+
+    std::atomic<bool> enabled{ true }, showing{ true }, focused{ false };
+
+    //stan harmonogramu puli
+    std::atomic<bool> running{ false };
+    std::atomic<int> skippedRounds{ 0 };
+};
+
+//wspólna dla wszystkich instancji wtyczki w procesie (juce::SharedResourcePointer)
+//co rundę (60 Hz) kolejkuje widoczne analizatory: najpierw ten z aktywnego okna, potem najdłużej pomijane;
+//mała pula wątków z podkradaniem zadań, łączny czas analizy ograniczony do maxCpuShare jednego rdzenia
+struct SpectrumAnalysisService
+{
+    SpectrumAnalysisService();
+    ~SpectrumAnalysisService();
+
+    void addClient(SpectrumAnalysisClient* client);
+    //po powrocie klient nie jest ani w kolejce, ani wykonywany
+    void removeClient(SpectrumAnalysisClient* client);
+
+    static constexpr int roundRateHz = 60;
+    static constexpr double maxCpuShare = 0.5;
+private:
+    struct Worker : juce::Thread
+    {
+        Worker(SpectrumAnalysisService& s, int i) : juce::Thread("Spectrum analysis " + juce::String(i)), service(s), index(i) {}
+        void run() override;
+
+        SpectrumAnalysisService& service;
+        const int index;
+    };
+
+    struct JobQueue
+    {
+        juce::SpinLock lock;
+        std::deque<SpectrumAnalysisClient*> jobs;
+    };
+
+    SpectrumAnalysisClient* takeJob(int workerIndex);
+    void runJob(SpectrumAnalysisClient& client);
+    bool scheduleRoundIfDue();
+    int getMillisecondsToNextRound() const;
+
+    juce::CriticalSection clientsLock;
+    std::vector<SpectrumAnalysisClient*> clients;
+
+    std::vector<std::unique_ptr<JobQueue>> queues;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::atomic<juce::int64> ticksUsedThisRound{ 0 };
+    juce::int64 roundBudgetTicks = 0;
+    std::atomic<double> nextRoundMs{ 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE(SpectrumAnalysisService)
+};
+
+//balistyka miernika po stronie GUI (jeden biegun, osobne czasy narastania i opadania)
+//dla redukcji wzmocnienia "atak" = ruch w stronę większej redukcji (niższe dB)
+//szczyt: największa redukcja z wejścia (bez wygładzania), trzymana holdMs, potem opada ze stałą prędkością w dB/s
+struct MeterBallistics
+{
+    void setTimes(float attackMs, float releaseMs, float updateRateHz)
+    {
+        auto coefficient = [updateRateHz](float timeMs)
+        {
+            return timeMs <= 0.f ? 0.f : std::exp(-1000.f / (timeMs * updateRateHz));
+        };
+        attackCoefficient = coefficient(attackMs);
+        releaseCoefficient = coefficient(releaseMs);
+    }
+
+    void setPeakHold(float holdMs, float decayDbPerSecond, float updateRateHz)
+    {
+        holdFrames = juce::jmax(0, juce::roundToInt(holdMs * updateRateHz / 1000.f));
+        peakDecayDb = decayDbPerSecond / updateRateHz;
+    }
+
+    float process(float target)
+    {
+        auto c = target < value ? attackCoefficient : releaseCoefficient;
+        value = target + c * (value - target);
+
+        if (target <= peak)
+        {
+            peak = target;
+            holdFramesLeft = holdFrames;
+        }
+        else if (holdFramesLeft > 0)
+        {
+            --holdFramesLeft;
+        }
+        else
+        {
+            peak = juce::jmin(target, peak + peakDecayDb);
+        }
+
+        return value;
+    }
+
+    float getValue() const { return value; }
+    float getPeak() const { return peak; }
+
+private:
+    float value = 0.f;
+    float attackCoefficient = 0.f;
+    float releaseCoefficient = 0.f;
+
+    float peak = 0.f;
+    int holdFrames = 0;
+    int holdFramesLeft = 0;
+    float peakDecayDb = std::numeric_limits<float>::max();
+};
+
 struct SpectrumAnalyzer : juce::Component,
     juce::AudioProcessorParameter::Listener,
     juce::Timer
@@ -209,12 +734,12 @@ struct SpectrumAnalyzer : juce::Component,
     void paint(juce::Graphics& g) override;
     void resized() override;
 
-    void toggleAnalysisEnablement(bool enabled)
-    {
-        shouldShowFFTAnalysis = enabled;
-    }
+    void toggleAnalysisEnablement(bool enabled);
 
-    void update(const std::vector<float>& values);
+    //wywoływane z timera edytora z częstotliwością updateRateHz
+    void update(const MeterSnapshot& meters);
+    void setGainReductionBallistics(float attackMs, float releaseMs, float updateRateHz);
+    void setGainReductionPeakHold(float holdMs, float decayDbPerSecond, float updateRateHz);
 private:
     Projekt_zespoowy_2022AudioProcessor& audioProcessor;
 
@@ -241,7 +766,46 @@ private:
 
     juce::Rectangle<int> getAnalysisArea();
 
-    PathProducer leftPathProducer, rightPathProducer;
+    //jeden analizowany punkt odczytu procesora: własne ścieżki, klient puli i ostatnia ramka
+    struct AnalyzerSlot
+    {
+        AnalyzerSlot(Projekt_zespoowy_2022AudioProcessor& p, AnalyzerTap initialTap) :
+            tap(initialTap),
+            pathProducer(p.getAnalyzerFifo(tap, Channel::Left), p.getAnalyzerFifo(tap, Channel::Right))
+        {
+        }
+
+        AnalyzerTap tap;
+        bool active = false;    //klient w puli, a przy włączonej analizie także odbiorca FIFO
+        juce::uint32 activationOrder = 0;
+        PathProducer pathProducer;
+        SpectrumAnalysisClient analysisClient{ pathProducer };
+        AnalyzerFrame frame;
+    };
+
+    //najwyżej tyle punktów odczytu naraz, ile procesor zasila; wybranie kolejnego zwalnia najstarszy
+    std::array<std::unique_ptr<AnalyzerSlot>, Projekt_zespoowy_2022AudioProcessor::maxActiveAnalyzerTaps> analyzerSlots;
+    juce::uint32 slotActivations = 0;
+    juce::SharedResourcePointer<SpectrumAnalysisService> analysisService;
+
+    std::array<juce::TextButton, (size_t)AnalyzerTap::numTaps> tapButtons;
+    //punkt odczytu, którego nie udało się włączyć (limit zajęty przez inne edytory); numTaps - brak
+    AnalyzerTap rejectedTap = AnalyzerTap::numTaps;
+
+    //false, gdy procesor nie przyjął odbiorcy - zwalniany slot wraca wtedy do poprzedniego punktu odczytu
+    bool activateTap(AnalyzerTap tap);
+    void attachSlot(AnalyzerSlot& slot, AnalyzerTap tap);
+    void deactivateSlot(AnalyzerSlot& slot);
+    void setupTapButtons();
+    void updateTapButtons();
+
+    AnalyzerGeometry getAnalyzerGeometry();
+
+    //rząd FFT, okno i jakość (zakładka, uśrednianie) - zmiana przebudowuje silnik na wątku analizy
+    juce::ComboBox fftOrderBox, windowBox, qualityBox;
+
+    void setupAnalyzerSettingsControls();
+    AnalyzerSettings getAnalyzerSettings() const;
  
     void drawCrossover(juce::Graphics& g);
 
@@ -254,10 +818,42 @@ private:
     juce::AudioParameterFloat* highMidThresholdParam{ nullptr };
     juce::AudioParameterFloat* highThresholdParam{ nullptr };
 
-    float lowBandGR{ 0.f };
-    float lowMidBandGR{ 0.f };
-    float highMidBandGR{ 0.f };
-    float highBandGR{ 0.f };
+    //słupki: maksymalna redukcja z bloku (z trzymanym szczytem), linia: średnia
+    std::array<MeterBallistics, 4> gainReductionMax;
+    std::array<MeterBallistics, 4> gainReductionMean;
+};
+
+//przewijana historia redukcji wzmocnienia pasm (ostatnie 5-30 s)
+//nowe kolumny dopisywane do obrazu w pamięci, paint tylko kopiuje obraz
+struct GainReductionHistory : juce::Component
+{
+    GainReductionHistory(Projekt_zespoowy_2022AudioProcessor&);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void mouseDown(const juce::MouseEvent&) override;
+
+    //wywoływane z timera edytora - pobiera wszystkie nowe ramki z wątku audio
+    void update();
+
+    void setHistoryLength(float seconds);
+
+private:
+    Projekt_zespoowy_2022AudioProcessor& audioProcessor;
+
+    static constexpr float minHistorySeconds = 5.f;
+    static constexpr float maxHistorySeconds = 30.f;
+    static constexpr float rangeDb = 24.f;
+
+    float historySeconds = 10.f;
+    juce::Image historyImage;
+
+    //kolumna w trakcie zbierania
+    GainReductionFrame pendingColumn;
+    float pendingSeconds = 0.f;
+
+    void resetPendingColumn();
+    void drawColumn(const GainReductionFrame& column);
 };
 
 struct LookAndFeel : juce::LookAndFeel_V4
@@ -451,7 +1047,8 @@ struct BandControls : juce::Component
 
 private:
     juce::AudioProcessorValueTreeState& apvts;
-    RotarySliderWithLabels attackLowSlider, releaseLowSlider, ratioLowSlider, kneeLowSlider;
+    RotarySliderWithLabels attackLowSlider, releaseLowSlider, ratioLowSlider, kneeLowSlider, mixLowSlider, linkLowSlider, detectorLowSlider,
+                           expanderThreshLowSlider, expanderRatioLowSlider, upwardThreshLowSlider, upwardRatioLowSlider;
     VerticalSlider threshLowSlider;
 
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
@@ -459,18 +1056,29 @@ private:
                                 releaseLowSliderAttachment,
                                 threshLowSliderAttachment,
                                 ratioLowSliderAttachment,
-                                kneeLowSliderAttachment;
+                                kneeLowSliderAttachment,
+        mixLowSliderAttachment,
+                                linkLowSliderAttachment,
+                                detectorLowSliderAttachment,
+                                expanderThreshLowSliderAttachment,
+                                expanderRatioLowSliderAttachment,
+                                upwardThreshLowSliderAttachment,
+                                upwardRatioLowSliderAttachment;
 
     juce::Label threshLabel;
 
     MuteButton muteLowButton;
     SoloButton soloLowButton;
     juce::ToggleButton bypassLowButton;
+    juce::ToggleButton autoReleaseLowButton;
+    juce::ToggleButton autoMakeupLowButton;
 
     using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
     std::unique_ptr<BtnAttachment> muteLowAttachment,
                                    soloLowAttachment,
-                                   bypassLowAttachment;
+                                   bypassLowAttachment,
+                                   autoReleaseLowAttachment,
+                                   autoMakeupLowAttachment;
 };
 
 struct BandLMControls : juce::Component
@@ -483,7 +1091,8 @@ struct BandLMControls : juce::Component
 
 private:
     juce::AudioProcessorValueTreeState& apvts;
-    RotarySliderWithLabels attackLowMidSlider, releaseLowMidSlider, ratioLowMidSlider, kneeLowMidSlider;
+    RotarySliderWithLabels attackLowMidSlider, releaseLowMidSlider, ratioLowMidSlider, kneeLowMidSlider, mixLowMidSlider, linkLowMidSlider, detectorLowMidSlider,
+                           expanderThreshLowMidSlider, expanderRatioLowMidSlider, upwardThreshLowMidSlider, upwardRatioLowMidSlider;
     VerticalSlider threshLowMidSlider;
 
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
@@ -492,18 +1101,29 @@ private:
         releaseLowMidSliderAttachment,
         threshLowMidSliderAttachment,
         ratioLowMidSliderAttachment,
-        kneeLowMidSliderAttachment;
+        kneeLowMidSliderAttachment,
+        mixLowMidSliderAttachment,
+                                linkLowMidSliderAttachment,
+                                detectorLowMidSliderAttachment,
+                                expanderThreshLowMidSliderAttachment,
+                                expanderRatioLowMidSliderAttachment,
+                                upwardThreshLowMidSliderAttachment,
+                                upwardRatioLowMidSliderAttachment;
 
     juce::Label threshLabel;
 
     MuteButton muteLowMidButton;
     SoloButton soloLowMidButton;
     juce::ToggleButton bypassLowMidButton;
+    juce::ToggleButton autoReleaseLowMidButton;
+    juce::ToggleButton autoMakeupLowMidButton;
 
     using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
     std::unique_ptr<BtnAttachment> muteLowMidAttachment,
         soloLowMidAttachment,
-        bypassLowMidAttachment;
+        bypassLowMidAttachment,
+                                   autoReleaseLowMidAttachment,
+                                   autoMakeupLowMidAttachment;
 };
 
 struct BandHMControls : juce::Component
@@ -516,7 +1136,8 @@ struct BandHMControls : juce::Component
 
 private:
     juce::AudioProcessorValueTreeState& apvts;
-    RotarySliderWithLabels attackHighMidSlider, releaseHighMidSlider, ratioHighMidSlider, kneeHighMidSlider;
+    RotarySliderWithLabels attackHighMidSlider, releaseHighMidSlider, ratioHighMidSlider, kneeHighMidSlider, mixHighMidSlider, linkHighMidSlider, detectorHighMidSlider,
+                           expanderThreshHighMidSlider, expanderRatioHighMidSlider, upwardThreshHighMidSlider, upwardRatioHighMidSlider;
     VerticalSlider threshHighMidSlider;
 
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
@@ -525,18 +1146,29 @@ private:
         releaseHighMidSliderAttachment,
         threshHighMidSliderAttachment,
         ratioHighMidSliderAttachment,
-        kneeHighMidSliderAttachment;
+        kneeHighMidSliderAttachment,
+        mixHighMidSliderAttachment,
+                                linkHighMidSliderAttachment,
+                                detectorHighMidSliderAttachment,
+                                expanderThreshHighMidSliderAttachment,
+                                expanderRatioHighMidSliderAttachment,
+                                upwardThreshHighMidSliderAttachment,
+                                upwardRatioHighMidSliderAttachment;
 
     juce::Label threshLabel;
 
     MuteButton muteHighMidButton;
     SoloButton soloHighMidButton;
     juce::ToggleButton bypassHighMidButton;
+    juce::ToggleButton autoReleaseHighMidButton;
+    juce::ToggleButton autoMakeupHighMidButton;
 
     using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
     std::unique_ptr<BtnAttachment> muteHighMidAttachment,
         soloHighMidAttachment,
-        bypassHighMidAttachment;
+        bypassHighMidAttachment,
+                                   autoReleaseHighMidAttachment,
+                                   autoMakeupHighMidAttachment;
 };
 
 struct BandHControls : juce::Component
@@ -549,7 +1181,8 @@ struct BandHControls : juce::Component
 
 private:
     juce::AudioProcessorValueTreeState& apvts;
-    RotarySliderWithLabels attackHighSlider, releaseHighSlider, ratioHighSlider, kneeHighSlider;
+    RotarySliderWithLabels attackHighSlider, releaseHighSlider, ratioHighSlider, kneeHighSlider, mixHighSlider, linkHighSlider, detectorHighSlider,
+                           expanderThreshHighSlider, expanderRatioHighSlider, upwardThreshHighSlider, upwardRatioHighSlider;
     VerticalSlider threshHighSlider;
 
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
@@ -558,18 +1191,29 @@ private:
         releaseHighSliderAttachment,
         threshHighSliderAttachment,
         ratioHighSliderAttachment,
-        kneeHighSliderAttachment;
+        kneeHighSliderAttachment,
+        mixHighSliderAttachment,
+                                linkHighSliderAttachment,
+                                detectorHighSliderAttachment,
+                                expanderThreshHighSliderAttachment,
+                                expanderRatioHighSliderAttachment,
+                                upwardThreshHighSliderAttachment,
+                                upwardRatioHighSliderAttachment;
 
     juce::Label threshLabel;
 
     MuteButton muteHighButton;
     SoloButton soloHighButton;
     juce::ToggleButton bypassHighButton;
+    juce::ToggleButton autoReleaseHighButton;
+    juce::ToggleButton autoMakeupHighButton;
 
     using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
     std::unique_ptr<BtnAttachment> muteHighAttachment,
         soloHighAttachment,
-        bypassHighAttachment;
+        bypassHighAttachment,
+                                   autoReleaseHighAttachment,
+                                   autoMakeupHighAttachment;
 };
 
 //==============================================================================
@@ -583,14 +1227,24 @@ struct GlobalControls : juce::Component
     void resized() override;
 private:
     using RSWL = RotarySliderWithLabels;
-    std::unique_ptr<RSWL> inputGainSlider, outputGainSlider, lowCrossoverSlider, midCrossoverSlider, highCrossoverSlider;
+    std::unique_ptr<RSWL> inputGainSlider, outputGainSlider, lowCrossoverSlider, midCrossoverSlider, highCrossoverSlider, globalMixSlider,
+                          limiterCeilingSlider, limiterReleaseSlider, crossoverSlopeSlider;
 
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::unique_ptr<Attachment> inputGainSliderAttachment,
                                 outputGainSliderAttachment,
                                 lowCrossoverSliderAttachment,
                                 midCrossoverSliderAttachment,
-                                highCrossoverSliderAttachment;
+                                highCrossoverSliderAttachment,
+                                globalMixSliderAttachment,
+                                limiterCeilingSliderAttachment,
+                                limiterReleaseSliderAttachment,
+                                crossoverSlopeSliderAttachment;
+
+    juce::ToggleButton limiterButton;
+
+    using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
+    std::unique_ptr<BtnAttachment> limiterButtonAttachment;
 };
 
 /**
@@ -622,6 +1276,11 @@ private:
     BandHControls bandHighControls{ audioProcessor.apvts };
 
     SpectrumAnalyzer analyzer {audioProcessor};
+    GainReductionHistory gainReductionHistory {audioProcessor};
+
+    MeterSnapshot meterSnapshot;
+
+    static constexpr int meterRefreshRateHz = 60;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Projekt_zespoowy_2022AudioProcessorEditor);
 };
@@ -38,6 +38,13 @@ Projekt_zespoowy_2022AudioProcessor::Projekt_zespoowy_2022AudioProcessor()
 		parameter = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(parameters.at(parameterName)));
 		jassert(parameter != nullptr);
 
+	};
+	//przekazywanie parametrów typu choice z apvts
+	auto choiceHelper = [&apvts = this->apvts, &parameters](auto& parameter, const auto& parameterName)
+	{
+		parameter = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(parameters.at(parameterName)));
+		jassert(parameter != nullptr);
+
 	};
 	//4 kompresory
 	floatHelper(lowComp.attack, Names::Attack_Low);
@@ -45,6 +52,15 @@ Projekt_zespoowy_2022AudioProcessor::Projekt_zespoowy_2022AudioProcessor()
 	floatHelper(lowComp.threshold, Names::Threshold_Low);
 	floatHelper(lowComp.ratio, Names::Ratio_Low);
 	floatHelper(lowComp.knee, Names::Knee_Low);
+	floatHelper(lowComp.mix, Names::Mix_Low);
+	boolHelper(lowComp.autoRelease, Names::Auto_Release_Low);
+	choiceHelper(lowComp.stereoLink, Names::Stereo_Link_Low);
+	choiceHelper(lowComp.detector, Names::Detector_Low);
+	floatHelper(lowComp.expanderThreshold, Names::Expander_Threshold_Low);
+	floatHelper(lowComp.expanderRatio, Names::Expander_Ratio_Low);
+	floatHelper(lowComp.upwardThreshold, Names::Upward_Threshold_Low);
+	floatHelper(lowComp.upwardRatio, Names::Upward_Ratio_Low);
+	boolHelper(lowComp.autoMakeup, Names::Auto_Makeup_Low);
 	boolHelper(lowComp.bypassed, Names::Bypassed_Low);
 	boolHelper(lowComp.mute, Names::Mute_Low);
 	boolHelper(lowComp.solo, Names::Solo_Low);
@@ -55,6 +71,15 @@ Projekt_zespoowy_2022AudioProcessor::Projekt_zespoowy_2022AudioProcessor()
 	floatHelper(lowMidComp.threshold, Names::Threshold_LowMid);
 	floatHelper(lowMidComp.ratio, Names::Ratio_LowMid);
 	floatHelper(lowMidComp.knee, Names::Knee_LowMid);
+	floatHelper(lowMidComp.mix, Names::Mix_LowMid);
+	boolHelper(lowMidComp.autoRelease, Names::Auto_Release_LowMid);
+	choiceHelper(lowMidComp.stereoLink, Names::Stereo_Link_LowMid);
+	choiceHelper(lowMidComp.detector, Names::Detector_LowMid);
+	floatHelper(lowMidComp.expanderThreshold, Names::Expander_Threshold_LowMid);
+	floatHelper(lowMidComp.expanderRatio, Names::Expander_Ratio_LowMid);
+	floatHelper(lowMidComp.upwardThreshold, Names::Upward_Threshold_LowMid);
+	floatHelper(lowMidComp.upwardRatio, Names::Upward_Ratio_LowMid);
+	boolHelper(lowMidComp.autoMakeup, Names::Auto_Makeup_LowMid);
 	boolHelper(lowMidComp.bypassed, Names::Bypassed_LowMid);
 	boolHelper(lowMidComp.mute, Names::Mute_LowMid);
 	boolHelper(lowMidComp.solo, Names::Solo_LowMid);
@@ -64,6 +89,15 @@ Projekt_zespoowy_2022AudioProcessor::Projekt_zespoowy_2022AudioProcessor()
 	floatHelper(highMidComp.threshold, Names::Threshold_HighMid);
 	floatHelper(highMidComp.ratio, Names::Ratio_HighMid);
 	floatHelper(highMidComp.knee, Names::Knee_HighMid);
+	floatHelper(highMidComp.mix, Names::Mix_HighMid);
+	boolHelper(highMidComp.autoRelease, Names::Auto_Release_HighMid);
+	choiceHelper(highMidComp.stereoLink, Names::Stereo_Link_HighMid);
+	choiceHelper(highMidComp.detector, Names::Detector_HighMid);
+	floatHelper(highMidComp.expanderThreshold, Names::Expander_Threshold_HighMid);
+	floatHelper(highMidComp.expanderRatio, Names::Expander_Ratio_HighMid);
+	floatHelper(highMidComp.upwardThreshold, Names::Upward_Threshold_HighMid);
+	floatHelper(highMidComp.upwardRatio, Names::Upward_Ratio_HighMid);
+	boolHelper(highMidComp.autoMakeup, Names::Auto_Makeup_HighMid);
 	boolHelper(highMidComp.bypassed, Names::Bypassed_HighMid);
 	boolHelper(highMidComp.mute, Names::Mute_HighMid);
 	boolHelper(highMidComp.solo, Names::Solo_HighMid);
@@ -73,6 +107,15 @@ Projekt_zespoowy_2022AudioProcessor::Projekt_zespoowy_2022AudioProcessor()
 	floatHelper(highComp.threshold, Names::Threshold_High);
 	floatHelper(highComp.ratio, Names::Ratio_High);
 	floatHelper(highComp.knee, Names::Knee_High);
+	floatHelper(highComp.mix, Names::Mix_High);
+	boolHelper(highComp.autoRelease, Names::Auto_Release_High);
+	choiceHelper(highComp.stereoLink, Names::Stereo_Link_High);
+	choiceHelper(highComp.detector, Names::Detector_High);
+	floatHelper(highComp.expanderThreshold, Names::Expander_Threshold_High);
+	floatHelper(highComp.expanderRatio, Names::Expander_Ratio_High);
+	floatHelper(highComp.upwardThreshold, Names::Upward_Threshold_High);
+	floatHelper(highComp.upwardRatio, Names::Upward_Ratio_High);
+	boolHelper(highComp.autoMakeup, Names::Auto_Makeup_High);
 	boolHelper(highComp.bypassed, Names::Bypassed_High);
 	boolHelper(highComp.mute, Names::Mute_High);
 	boolHelper(highComp.solo, Names::Solo_High);
@@ -83,20 +126,18 @@ Projekt_zespoowy_2022AudioProcessor::Projekt_zespoowy_2022AudioProcessor()
 	floatHelper(lowLowMidCrossover, Names::Low_LowMid_Crossover_Freq);
 	floatHelper(lowMidHighMidCrossover, Names::LowMid_HighMid_Crossover_Freq);
 	floatHelper(highMidHighCrossover, Names::HighMid_High_Crossover_Freq);
-	
-	LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-	LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-	LP3.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-	HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-	HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-	HP3.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+	choiceHelper(crossoverSlopeParameter, Names::Crossover_Slope);
 
 	//wzmocnienie
 	floatHelper(inputGainParameter, Names::Input_Gain);
 	floatHelper(outputGainParameter, Names::Output_Gain);
+	floatHelper(globalMixParameter, Names::Global_Mix);
 
+	//limiter
+	boolHelper(limiter.enabled, Names::Limiter_Enabled);
+	floatHelper(limiter.ceiling, Names::Limiter_Ceiling);
+	floatHelper(limiter.release, Names::Limiter_Release);
 
-	//invAP.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
 
     //tutaj jest konstruktor ¿eby parametry nie by³y przekazywane w ka¿dej partii próbek tylko raz
 }
@@ -179,24 +220,29 @@ void Projekt_zespoowy_2022AudioProcessor::prepareToPlay(double sampleRate, int s
 	spec.numChannels = getTotalNumOutputChannels();
 	spec.sampleRate = sampleRate;
 
-	//LATENCJA :(
-	AudioProcessor::setLatencySamples(0);
+	//limiter
+	limiter.prepare(spec);
+
+	//LATENCJA - suma wszystkich etapów
+	auto latencySamples = 0;
+	latencySamples += limiter.getLatencySamples();
+	AudioProcessor::setLatencySamples(latencySamples);
 	
 
 	for(auto &comp:compressors)
+	{
 		comp.prepare(spec);
+		//tor mokry pasm nie ma jeszcze latencji - suchy bez opóźnienia
+		comp.setDryDelay(0);
+	}
 
 	//filtry
-	LP1.prepare(spec);
-	LP2.prepare(spec);
-	LP3.prepare(spec);
-	HP1.prepare(spec);
-	HP2.prepare(spec);
-	HP3.prepare(spec);
-	
-	//allpass
-	//invAP.prepare(spec);
-	//invAPBuffer.setSize(spec.numChannels, samplesPerBlock);
+	crossoverLR2.prepare(spec);
+	crossoverLR4.prepare(spec);
+	crossoverLR8.prepare(spec);
+	crossoverNeedsReset = true;
+	crossoverFadeRemaining = 0;
+	crossoverFadeLength = juce::jmax(1, juce::roundToInt(sampleRate * crossoverFadeSeconds));
 		
 	//wzmocnienie
 	inputGain.prepare(spec);
@@ -210,8 +256,21 @@ void Projekt_zespoowy_2022AudioProcessor::prepareToPlay(double sampleRate, int s
 		buffer.setSize(spec.numChannels, samplesPerBlock);
 	}
 
-	leftChannelFifo.prepare(samplesPerBlock);
-	rightChannelFifo.prepare(samplesPerBlock);
+	for (auto& buffer : fadingFilterBuffers)
+	{
+		buffer.setSize(spec.numChannels, samplesPerBlock);
+	}
+
+	//FIFO analizatora alokowane tylko dla punktów odczytu, które ktoś czyta
+	//wątek analizy może je właśnie czytać - prepare()/release() czekają na koniec odczytu
+	analyzerBlockSize = samplesPerBlock;
+	for (auto& tap : analyzerTaps)
+	{
+		if (tap.consumers.load() > 0)
+			prepareAnalyzerFifos(tap);
+		else
+			releaseAnalyzerFifos(tap);
+	}
 
 }
 void Projekt_zespoowy_2022AudioProcessor::releaseResources()
@@ -220,6 +279,174 @@ void Projekt_zespoowy_2022AudioProcessor::releaseResources()
     // spare memory, etc.
 }
 
+int Projekt_zespoowy_2022AudioProcessor::getNumActiveAnalyzerTaps() const
+{
+	auto numActive = 0;
+	for (auto& tap : analyzerTaps)
+		numActive += tap.consumers.load() > 0 ? 1 : 0;
+
+	return numActive;
+}
+
+bool Projekt_zespoowy_2022AudioProcessor::canAddAnalyzerConsumer(AnalyzerTap tapToAdd) const
+{
+	return analyzerTaps[(size_t)tapToAdd].consumers.load() > 0
+		|| getNumActiveAnalyzerTaps() < maxActiveAnalyzerTaps;
+}
+
+bool Projekt_zespoowy_2022AudioProcessor::canAddAnalyzerConsumer(AnalyzerTap tapToAdd, AnalyzerTap releasedTap) const
+{
+	if (analyzerTaps[(size_t)tapToAdd].consumers.load() > 0)
+		return true;
+
+	auto numActive = getNumActiveAnalyzerTaps();
+	if (releasedTap != tapToAdd && analyzerTaps[(size_t)releasedTap].consumers.load() == 1)
+		--numActive;
+
+	return numActive < maxActiveAnalyzerTaps;
+}
+
+bool Projekt_zespoowy_2022AudioProcessor::addAnalyzerConsumer(AnalyzerTap tapToAdd)
+{
+	auto& tap = analyzerTaps[(size_t)tapToAdd];
+
+	//wątek GUI; przy zerowej liczbie odbiorców wątek audio nie dotyka FIFO, więc można alokować
+	if (tap.consumers.load() == 0)
+	{
+		if (getNumActiveAnalyzerTaps() >= maxActiveAnalyzerTaps)
+			return false;
+
+		if (!tap.allocated && analyzerBlockSize > 0)
+			prepareAnalyzerFifos(tap);
+	}
+
+	tap.consumers.fetch_add(1);
+	return true;
+}
+
+void Projekt_zespoowy_2022AudioProcessor::removeAnalyzerConsumer(AnalyzerTap tapToRemove)
+{
+	auto& tap = analyzerTaps[(size_t)tapToRemove];
+	jassert(tap.consumers.load() > 0);
+	//skasowanie potwierdzenia przed zejściem do zera - każde późniejsze potwierdzenie
+	//pochodzi z bloku, który już widział brak odbiorców
+	tap.idle.store(false);
+	if (tap.consumers.fetch_sub(1) == 1)
+		analyzerFifoReleaser.startTimer(analyzerReleaseDelayMs);
+}
+
+Projekt_zespoowy_2022AudioProcessor::AnalyzerFifo& Projekt_zespoowy_2022AudioProcessor::getAnalyzerFifo(AnalyzerTap tap, Channel channel)
+{
+	auto& fifos = analyzerTaps[(size_t)tap];
+	return channel == Channel::Left ? fifos.left : fifos.right;
+}
+
+void Projekt_zespoowy_2022AudioProcessor::feedAnalyzerTap(AnalyzerTap tapToFeed, const BlockType& block)
+{
+	auto& tap = analyzerTaps[(size_t)tapToFeed];
+	if (tap.consumers.load() > 0)
+	{
+		tap.left.update(block);
+		tap.right.update(block);
+	}
+	else
+	{
+		tap.idle.store(true);
+	}
+}
+
+void Projekt_zespoowy_2022AudioProcessor::feedAnalyzerBandTap(size_t band)
+{
+	auto& tap = analyzerTaps[(size_t)AnalyzerTap::low + band];
+	if (tap.consumers.load() == 0)
+	{
+		tap.idle.store(true);
+		return;
+	}
+
+	const auto& comp = compressors[band];
+	const auto& wet = filterBuffers[band];
+	const auto numSamples = wet.getNumSamples();
+
+	if (!comp.needsDrySignal() && !comp.needsMakeupGain())
+	{
+		tap.left.update(wet);
+		tap.right.update(wet);
+		return;
+	}
+
+	//to samo co w sumowaniu pasm: dry + g * (m * wet - dry), rampy g (wet) i m (makeup) na długości bloku
+	const auto& wetRamp = comp.getWetGainRamp();
+	const auto& makeupRamp = comp.getMakeupGainRamp();
+	const auto wetStep = (wetRamp.end - wetRamp.start) / static_cast<float>(numSamples);
+	const auto makeupStep = (makeupRamp.end - makeupRamp.start) / static_cast<float>(numSamples);
+	const auto needsDry = comp.needsDrySignal();
+	const auto& dry = comp.getDryBuffer();
+
+	auto fill = [&](float* dest, int channel, int startSample, int count)
+	{
+		const auto* wetIn = wet.getReadPointer(channel, startSample);
+		const auto m0 = makeupRamp.start + makeupStep * static_cast<float>(startSample);
+
+		if (!needsDry)
+		{
+			for (auto n = 0; n < count; ++n)
+				dest[n] = (m0 + makeupStep * static_cast<float>(n)) * wetIn[n];
+			return;
+		}
+
+		const auto* dryIn = dry.getReadPointer(channel, startSample);
+		const auto g0 = wetRamp.start + wetStep * static_cast<float>(startSample);
+		for (auto n = 0; n < count; ++n)
+		{
+			const auto g = g0 + wetStep * static_cast<float>(n);
+			const auto m = m0 + makeupStep * static_cast<float>(n);
+			dest[n] = dryIn[n] + g * (m * wetIn[n] - dryIn[n]);
+		}
+	};
+
+	tap.left.update(numSamples, fill);
+	tap.right.update(numSamples, fill);
+}
+
+void Projekt_zespoowy_2022AudioProcessor::prepareAnalyzerFifos(AnalyzerTapFifos& tap)
+{
+	tap.left.prepare(analyzerBlockSize);
+	tap.right.prepare(analyzerBlockSize);
+	tap.allocated = true;
+}
+
+void Projekt_zespoowy_2022AudioProcessor::releaseAnalyzerFifos(AnalyzerTapFifos& tap)
+{
+	tap.left.release();
+	tap.right.release();
+	tap.allocated = false;
+}
+
+void Projekt_zespoowy_2022AudioProcessor::releaseAnalyzerFifosIfIdle()
+{
+	//bez potwierdzenia (np. transport zatrzymany w trakcie bloku) próba przy następnym tyknięciu
+	auto pending = false;
+	for (auto& tap : analyzerTaps)
+	{
+		if (tap.consumers.load() > 0 || !tap.allocated)
+			continue;
+
+		if (tap.idle.load())
+			releaseAnalyzerFifos(tap);
+		else
+			pending = true;
+	}
+
+	if (!pending)
+		analyzerFifoReleaser.stopTimer();
+}
+
+void Projekt_zespoowy_2022AudioProcessor::AnalyzerFifoReleaser::timerCallback()
+{
+	processor.releaseAnalyzerFifosIfIdle();
+}
+
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool Projekt_zespoowy_2022AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
@@ -261,8 +488,21 @@ void Projekt_zespoowy_2022AudioProcessor::processBlock (juce::AudioBuffer<float>
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-	leftChannelFifo.update(buffer);
-	rightChannelFifo.update(buffer);
+	//analizator zasilany tylko przy podłączonym odbiorcy; blok bez zasilania potwierdza bezczynność
+	feedAnalyzerTap(AnalyzerTap::pre, buffer);
+
+	//poziom RMS (średnia kanałów) w dB dla mierników
+	auto rmsLevelDb = [](const juce::AudioBuffer<float>& b)
+	{
+		auto rms = 0.f;
+		for (auto ch = 0; ch < b.getNumChannels(); ++ch)
+			rms += b.getRMSLevel(ch, 0, b.getNumSamples());
+		rms /= static_cast<float>(juce::jmax(1, b.getNumChannels()));
+		return juce::Decibels::gainToDecibels(rms, -48.f);
+	};
+
+	MeterSnapshot meters;
+	meters.inputRmsDb = rmsLevelDb(buffer);
 
 	for (auto& compressor : compressors)
 		compressor.updateCompressorSettings();
@@ -297,88 +537,122 @@ void Projekt_zespoowy_2022AudioProcessor::processBlock (juce::AudioBuffer<float>
 	inputGain.process(inputGainCtx);
    	
 	//filtry
-	//kopiowanie buforów
-
-	for (auto& fb : filterBuffers)
-	{
-		fb = buffer;
-	}
-
 	//ustawienie częstotliwości filtrów
 	auto lowLowMidCutoff = lowLowMidCrossover -> get();
-	LP1.setCutoffFrequency(lowLowMidCutoff);
-	HP1.setCutoffFrequency(lowLowMidCutoff);
-
 	auto lowMidHighMidCutoff = lowMidHighMidCrossover -> get();
-	LP2.setCutoffFrequency(lowMidHighMidCutoff);
-	HP2.setCutoffFrequency(lowMidHighMidCutoff);
-
 	auto highMidHighCutoff = highMidHighCrossover -> get();
-	LP3.setCutoffFrequency(highMidHighCutoff);
-	HP3.setCutoffFrequency(highMidHighCutoff);
 
-	auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-	auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-	auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
-	auto fb3Block = juce::dsp::AudioBlock<float>(filterBuffers[3]);
-	
-	auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
-	auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
-	auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
-	auto fb3Ctx = juce::dsp::ProcessContextReplacing<float>(fb3Block);
-	
-	//filtry
-	/*
-	//filtry do buforów
-	LP1.process(fb0Ctx);
-	AP2.process(fb0Ctx);
-	AP3.process(fb0Ctx);
+	//podział na pasma - nachylenie wybierane w czasie działania, filtry specjalizowane w czasie kompilacji
+	using Parameters::CrossoverSlope;
+	auto withSplitter = [this](CrossoverSlope slope, auto&& function)
+	{
+		switch (slope)
+		{
+			case CrossoverSlope::db12PerOct: function(crossoverLR2); break;
+			case CrossoverSlope::db48PerOct: function(crossoverLR8); break;
+			default:                         function(crossoverLR4); break;
+		}
+	};
 
-	HP1.process(fb1Ctx);
-	filterBuffers[2] = filterBuffers[1];
-	
-	LP2.process(fb1Ctx);
-	AP3.process(fb1Ctx);
+	auto splitBands = [&](CrossoverSlope slope, std::array<juce::AudioBuffer<float>, 4>& destinations)
+	{
+		withSplitter(slope, [&](auto& splitter)
+		{
+			splitter.setCutoffFrequencies(lowLowMidCutoff, lowMidHighMidCutoff, highMidHighCutoff);
+			splitter.process(buffer, destinations);
+		});
+	};
 
-	HP2.process(fb2Ctx);
-	filterBuffers[3] = filterBuffers[2];
-	LP3.process(fb2Ctx);
-	
-	HP3.process(fb3Ctx);
-	*/
-	
-	//LOW = LP2 + LP1
-	LP2.process(fb1Ctx);
-	filterBuffers[0] = filterBuffers[1];
-	LP1.process(fb0Ctx);
+	//nowy podział startuje z wyzerowanym stanem; przy pierwszym bloku bez przejścia
+	auto requestedSlope = static_cast<CrossoverSlope>(crossoverSlopeParameter->getIndex());
+	if (crossoverNeedsReset)
+	{
+		crossoverSlope = requestedSlope;
+		withSplitter(crossoverSlope, [](auto& splitter) { splitter.reset(); });
+		crossoverNeedsReset = false;
+	}
+	else if (requestedSlope != crossoverSlope && crossoverFadeRemaining == 0)
+	{
+		fadingCrossoverSlope = crossoverSlope;
+		crossoverSlope = requestedSlope;
+		withSplitter(crossoverSlope, [](auto& splitter) { splitter.reset(); });
+		crossoverFadeRemaining = crossoverFadeLength;
+	}
 
-	//LOWMID = LP2 + HP1
-	HP1.process(fb1Ctx);
+	splitBands(crossoverSlope, filterBuffers);
+
+	if (crossoverFadeRemaining > 0)
+	{
+		splitBands(fadingCrossoverSlope, fadingFilterBuffers);
 
-	//HIGHMID = HP2 + LP3
-	HP2.process(fb3Ctx);
-	filterBuffers[2] = filterBuffers[3];
-	LP3.process(fb2Ctx);
+		//pasmo = nowe * g + stare * (1 - g), g rośnie liniowo od 0 do 1
+		const auto fadeSamples = juce::jmin(buffer.getNumSamples(), crossoverFadeRemaining);
+		const auto fadeLength = static_cast<float>(crossoverFadeLength);
+		const auto gainStart = 1.f - static_cast<float>(crossoverFadeRemaining) / fadeLength;
+		const auto gainEnd = 1.f - static_cast<float>(crossoverFadeRemaining - fadeSamples) / fadeLength;
+
+		for (size_t band = 0; band < filterBuffers.size(); ++band)
+		{
+			auto& target = filterBuffers[band];
+			const auto& fading = fadingFilterBuffers[band];
+			for (auto ch = 0; ch < target.getNumChannels(); ++ch)
+			{
+				target.applyGainRamp(ch, 0, fadeSamples, gainStart, gainEnd);
+				target.addFromWithRamp(ch, 0, fading.getReadPointer(ch), fadeSamples, 1.f - gainStart, 1.f - gainEnd);
+			}
+		}
 
-	//HIGH = HP2 + HP3
-	HP3.process(fb3Ctx);
+		crossoverFadeRemaining -= fadeSamples;
+	}
 
 	//kompresowanie pasm
+	auto globalMix = globalMixParameter->get() * 0.01f;
 	for (size_t i = 0; i < filterBuffers.size(); i++)
-		compressors[i].process(filterBuffers[i]);
+	{
+		compressors[i].process(filterBuffers[i], globalMix);
+		feedAnalyzerBandTap(i);
+	}
 
 	auto numSamples = buffer.getNumSamples();
 	auto numChannels = buffer.getNumChannels();
 
 	buffer.clear();
 
-	//lambda przechwytywanie pasm
-	auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
+	//lambda przechwytywanie pasm, miks dry/wet i makeup liczone w tym samym przejściu co sumowanie
+	auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source, const CompressorBand& comp)
 	{
-		for(auto i = 0; i < nc; ++i)
+		const auto& wet = comp.getWetGainRamp();
+		const auto& makeup = comp.getMakeupGainRamp();
+
+		if (!comp.needsDrySignal())
+		{
+			for (auto i = 0; i < nc; ++i)
+			{
+				//(docelowy kanał, docelowa próbka startowa, bufor źródłowy, kanał źródłowy, źródłowa próbka startowa, liczba próbek)
+				if (comp.needsMakeupGain())
+					inputBuffer.addFromWithRamp(i, 0, source.getReadPointer(i), ns, makeup.start, makeup.end);
+				else
+					inputBuffer.addFrom(i, 0, source, i, 0, ns);
+			}
+			return;
+		}
+
+		const auto& dry = comp.getDryBuffer();
+		const auto wetStep = (wet.end - wet.start) / static_cast<float>(ns);
+		const auto makeupStep = (makeup.end - makeup.start) / static_cast<float>(ns);
+		for (auto i = 0; i < nc; ++i)
 		{
-			//(docelowy kanał, docelowa próbka startowa, bufor źródłowy, kanał źródłowy, źródłowa próbka startowa, liczba próbek)
-			inputBuffer.addFrom(i, 0, source, i, 0, ns);
+			auto* out = inputBuffer.getWritePointer(i);
+			auto* wetIn = source.getReadPointer(i);
+			auto* dryIn = dry.getReadPointer(i);
+
+			//out += dry + g * (m * wet - dry)
+			for (auto n = 0; n < ns; ++n)
+			{
+				auto g = wet.start + wetStep * static_cast<float>(n);
+				auto m = makeup.start + makeupStep * static_cast<float>(n);
+				out[n] += dryIn[n] + g * (m * wetIn[n] - dryIn[n]);
+			}
 		}
 	};
 
@@ -402,7 +676,7 @@ void Projekt_zespoowy_2022AudioProcessor::processBlock (juce::AudioBuffer<float>
 			if (comp.solo->get())
 			{
 				//jeśli wysolowane - dodaj do bufora
-				addFilterBand(buffer, filterBuffers[i]);
+				addFilterBand(buffer, filterBuffers[i], comp);
 			}
 		}
 	}
@@ -414,7 +688,7 @@ void Projekt_zespoowy_2022AudioProcessor::processBlock (juce::AudioBuffer<float>
 			if (!comp.mute->get())
 			{
 				//jeśli nie zmutowane, dodaj
-				addFilterBand(buffer, filterBuffers[i]);
+				addFilterBand(buffer, filterBuffers[i], comp);
 			}
 		}
 	}
@@ -422,6 +696,27 @@ void Projekt_zespoowy_2022AudioProcessor::processBlock (juce::AudioBuffer<float>
 	//wzmocnienie output
 	outputGain.process(outputGainCtx);
 
+	//limiter (stała latencja, również gdy wyłączony)
+	limiter.process(buffer);
+
+	feedAnalyzerTap(AnalyzerTap::post, buffer);
+
+	//jedna publikacja na blok - edytor widzi spójny stan wszystkich pasm
+	for (size_t i = 0; i < compressors.size(); ++i)
+		meters.bands[i] = compressors[i].getMeterValues();
+	meters.outputRmsDb = rmsLevelDb(buffer);
+	meterSnapshots.push(meters);
+
+	//przy pełnej kolejce (brak edytora) ramka jest po prostu pomijana
+	GainReductionFrame grFrame;
+	for (size_t i = 0; i < compressors.size(); ++i)
+	{
+		grFrame.minDb[i] = meters.bands[i].gainReductionMaxDb;
+		grFrame.maxDb[i] = meters.bands[i].gainReductionMinDb;
+	}
+	grFrame.durationSeconds = static_cast<float>(numSamples / getSampleRate());
+	gainReductionHistory.push(grFrame);
+
 	/*
 	addFilterBand(buffer, filterBuffers[0]);
 	addFilterBand(buffer, filterBuffers[1]);
@@ -429,23 +724,6 @@ void Projekt_zespoowy_2022AudioProcessor::processBlock (juce::AudioBuffer<float>
 	addFilterBand(buffer, filterBuffers[3]);
 	*/
 
-	//allpass do testu
-	/*
-	//invAPBuffer = buffer;
-	invAP.setCutoffFrequency(20000);
-	auto invAPBlock = juce::dsp::AudioBlock<float>(invAPBuffer);
-	auto invAPCtx = juce::dsp::ProcessContextReplacing<float>(invAPBlock);
-	invAP.process(invAPCtx);
-	//jeśli bypass włączony - odwracamy cały sygnał
-	if (compressor.bypassed->get()) 
-	{
-		for (auto ch = 0; ch < numChannels; ++ch)
-		{
-			juce::FloatVectorOperations::multiply(invAPBuffer.getWritePointer(ch), -1.f, numSamples);
-		}
-		addFilterBand(buffer, invAPBuffer);
-	}
-	*/	
 }
 
 //==============================================================================
@@ -494,6 +772,11 @@ juce::AudioProcessorValueTreeState::ParameterLayout Projekt_zespoowy_2022AudioPr
 	auto attackReleaseRange = NormalisableRange<float>(1, 500, 1, 1);
 	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Input_Gain), parameters.at(Names::Input_Gain), NormalisableRange<float>(-20.0f, 20.0f, 0.1f, 1.0f), 0));
 	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Output_Gain), parameters.at(Names::Output_Gain), NormalisableRange<float>(-20.0f, 20.0f, 0.1f, 1.0f), 0));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Global_Mix), parameters.at(Names::Global_Mix), NormalisableRange<float>(0, 100, 1, 1), 100));
+
+	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Limiter_Enabled), parameters.at(Names::Limiter_Enabled), false));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Limiter_Ceiling), parameters.at(Names::Limiter_Ceiling), NormalisableRange<float>(-12.0f, 0.0f, 0.1f, 1.0f), -0.3f));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Limiter_Release), parameters.at(Names::Limiter_Release), attackReleaseRange, 50));
 
 
 	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Threshold_Low), parameters.at(Names::Threshold_Low), NormalisableRange<float>(-48, 0, 1, 1), 0));
@@ -520,6 +803,11 @@ juce::AudioProcessorValueTreeState::ParameterLayout Projekt_zespoowy_2022AudioPr
 	layout.add(std::make_unique <AudioParameterFloat>(parameters.at(Names::Knee_LowMid), parameters.at(Names::Knee_LowMid), NormalisableRange<float>(0, 1, 0.01, 1), 0));
 	layout.add(std::make_unique <AudioParameterFloat>(parameters.at(Names::Knee_HighMid), parameters.at(Names::Knee_HighMid), NormalisableRange<float>(0, 1, 0.01, 1), 0));
 	layout.add(std::make_unique <AudioParameterFloat>(parameters.at(Names::Knee_High), parameters.at(Names::Knee_High), NormalisableRange<float>(0, 1, 0.01, 1), 0));
+
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Mix_Low), parameters.at(Names::Mix_Low), NormalisableRange<float>(0, 100, 1, 1), 100));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Mix_LowMid), parameters.at(Names::Mix_LowMid), NormalisableRange<float>(0, 100, 1, 1), 100));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Mix_HighMid), parameters.at(Names::Mix_HighMid), NormalisableRange<float>(0, 100, 1, 1), 100));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Mix_High), parameters.at(Names::Mix_High), NormalisableRange<float>(0, 100, 1, 1), 100));
 	
 	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Bypassed_Low), parameters.at(Names::Bypassed_Low), false));
 	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Bypassed_LowMid), parameters.at(Names::Bypassed_LowMid), false));
@@ -536,9 +824,50 @@ juce::AudioProcessorValueTreeState::ParameterLayout Projekt_zespoowy_2022AudioPr
 	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Mute_HighMid), parameters.at(Names::Mute_HighMid), false));
 	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Mute_High), parameters.at(Names::Mute_High), false));
 
+	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Auto_Release_Low), parameters.at(Names::Auto_Release_Low), false));
+	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Auto_Release_LowMid), parameters.at(Names::Auto_Release_LowMid), false));
+	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Auto_Release_HighMid), parameters.at(Names::Auto_Release_HighMid), false));
+	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Auto_Release_High), parameters.at(Names::Auto_Release_High), false));
+
+	layout.add(std::make_unique<AudioParameterChoice>(parameters.at(Names::Stereo_Link_Low), parameters.at(Names::Stereo_Link_Low), StringArray{ "Max", "Mean", "Unlinked" }, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(parameters.at(Names::Stereo_Link_LowMid), parameters.at(Names::Stereo_Link_LowMid), StringArray{ "Max", "Mean", "Unlinked" }, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(parameters.at(Names::Stereo_Link_HighMid), parameters.at(Names::Stereo_Link_HighMid), StringArray{ "Max", "Mean", "Unlinked" }, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(parameters.at(Names::Stereo_Link_High), parameters.at(Names::Stereo_Link_High), StringArray{ "Max", "Mean", "Unlinked" }, 0));
+
+	layout.add(std::make_unique<AudioParameterChoice>(parameters.at(Names::Detector_Low), parameters.at(Names::Detector_Low), StringArray{ "Peak", "RMS" }, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(parameters.at(Names::Detector_LowMid), parameters.at(Names::Detector_LowMid), StringArray{ "Peak", "RMS" }, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(parameters.at(Names::Detector_HighMid), parameters.at(Names::Detector_HighMid), StringArray{ "Peak", "RMS" }, 0));
+	layout.add(std::make_unique<AudioParameterChoice>(parameters.at(Names::Detector_High), parameters.at(Names::Detector_High), StringArray{ "Peak", "RMS" }, 0));
+
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Expander_Threshold_Low), parameters.at(Names::Expander_Threshold_Low), NormalisableRange<float>(-96, 0, 1, 1), -96));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Expander_Threshold_LowMid), parameters.at(Names::Expander_Threshold_LowMid), NormalisableRange<float>(-96, 0, 1, 1), -96));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Expander_Threshold_HighMid), parameters.at(Names::Expander_Threshold_HighMid), NormalisableRange<float>(-96, 0, 1, 1), -96));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Expander_Threshold_High), parameters.at(Names::Expander_Threshold_High), NormalisableRange<float>(-96, 0, 1, 1), -96));
+
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Expander_Ratio_Low), parameters.at(Names::Expander_Ratio_Low), NormalisableRange<float>(1, 10, 0.1, 0.5f), 1));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Expander_Ratio_LowMid), parameters.at(Names::Expander_Ratio_LowMid), NormalisableRange<float>(1, 10, 0.1, 0.5f), 1));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Expander_Ratio_HighMid), parameters.at(Names::Expander_Ratio_HighMid), NormalisableRange<float>(1, 10, 0.1, 0.5f), 1));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Expander_Ratio_High), parameters.at(Names::Expander_Ratio_High), NormalisableRange<float>(1, 10, 0.1, 0.5f), 1));
+
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Upward_Threshold_Low), parameters.at(Names::Upward_Threshold_Low), NormalisableRange<float>(-96, 0, 1, 1), -96));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Upward_Threshold_LowMid), parameters.at(Names::Upward_Threshold_LowMid), NormalisableRange<float>(-96, 0, 1, 1), -96));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Upward_Threshold_HighMid), parameters.at(Names::Upward_Threshold_HighMid), NormalisableRange<float>(-96, 0, 1, 1), -96));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Upward_Threshold_High), parameters.at(Names::Upward_Threshold_High), NormalisableRange<float>(-96, 0, 1, 1), -96));
+
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Upward_Ratio_Low), parameters.at(Names::Upward_Ratio_Low), NormalisableRange<float>(1, 10, 0.1, 0.5f), 1));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Upward_Ratio_LowMid), parameters.at(Names::Upward_Ratio_LowMid), NormalisableRange<float>(1, 10, 0.1, 0.5f), 1));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Upward_Ratio_HighMid), parameters.at(Names::Upward_Ratio_HighMid), NormalisableRange<float>(1, 10, 0.1, 0.5f), 1));
+	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Upward_Ratio_High), parameters.at(Names::Upward_Ratio_High), NormalisableRange<float>(1, 10, 0.1, 0.5f), 1));
+
+	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Auto_Makeup_Low), parameters.at(Names::Auto_Makeup_Low), false));
+	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Auto_Makeup_LowMid), parameters.at(Names::Auto_Makeup_LowMid), false));
+	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Auto_Makeup_HighMid), parameters.at(Names::Auto_Makeup_HighMid), false));
+	layout.add(std::make_unique<AudioParameterBool>(parameters.at(Names::Auto_Makeup_High), parameters.at(Names::Auto_Makeup_High), false));
+
 	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::Low_LowMid_Crossover_Freq), parameters.at(Names::Low_LowMid_Crossover_Freq), NormalisableRange<float>(20, 250, 1, 1), 200));
 	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::LowMid_HighMid_Crossover_Freq), parameters.at(Names::LowMid_HighMid_Crossover_Freq), NormalisableRange<float>(500, 2000, 1, 1), 1500));
 	layout.add(std::make_unique<AudioParameterFloat>(parameters.at(Names::HighMid_High_Crossover_Freq), parameters.at(Names::HighMid_High_Crossover_Freq), NormalisableRange<float>(5000, 20000, 1, 1), 6300));
+	layout.add(std::make_unique<AudioParameterChoice>(parameters.at(Names::Crossover_Slope), parameters.at(Names::Crossover_Slope), GetCrossoverSlopeChoices(), static_cast<int>(CrossoverSlope::db24PerOct)));
 	
    
 	/*
@@ -11,7 +11,7 @@
 #include <JuceHeader.h>
 
 #include <array>
-template<typename T>
+template<typename T, int Capacity = 30>
 struct Fifo
 {
     void prepare(int numChannels, int numSamples)
@@ -69,17 +69,181 @@ struct Fifo
         return fifo.getNumReady();
     }
 private:
-    static constexpr int Capacity = 30;
     std::array<T, Capacity> buffers;
     juce::AbstractFifo fifo{ Capacity };
 };
 
+//potrójny bufor: jeden zapisujący (wątek audio), jeden czytający (GUI), bez blokad i alokacji
+//push nadpisuje poprzednią nieodczytaną wartość, pull zwraca zawsze najnowszą kompletną
+template<typename T>
+struct TripleBuffer
+{
+    void push(const T& t)
+    {
+        buffers[(size_t)backIndex] = t;
+        backIndex = middle.exchange(backIndex | newDataFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    bool pull(T& t)
+    {
+        if ((middle.load(std::memory_order_acquire) & newDataFlag) == 0)
+            return false;
+
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+        t = buffers[(size_t)frontIndex];
+        return true;
+    }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int newDataFlag = 4;
+
+    std::array<T, 3> buffers{};
+    std::atomic<int> middle{ 1 };
+    int backIndex = 0;    //tylko wątek zapisujący
+    int frontIndex = 2;   //tylko wątek czytający
+};
+
+//pierścień próbek float: jeden zapisujący (wątek audio), jeden czytający (GUI), bez blokad
+//zapis to najwyżej dwa memcpy, odczyt to widok na pamięć pierścienia bez kopiowania
+//próbki, które się nie mieszczą, są odrzucane i zliczane
+struct SampleRingBuffer
+{
+    //dwa ciągłe fragmenty pamięci pierścienia (drugi niepusty tylko przy zawinięciu)
+    struct ReadView
+    {
+        const float* data1 = nullptr;
+        int size1 = 0;
+        const float* data2 = nullptr;
+        int size2 = 0;
+
+        int getNumSamples() const { return size1 + size2; }
+
+        void copyTo(float* dest, int startSample, int numSamples) const
+        {
+            jassert(startSample >= 0 && startSample + numSamples <= getNumSamples());
+            if (startSample < size1)
+            {
+                const auto n1 = juce::jmin(numSamples, size1 - startSample);
+                std::memcpy(dest, data1 + startSample, sizeof(float) * (size_t)n1);
+                dest += n1;
+                numSamples -= n1;
+                startSample = 0;
+            }
+            else
+            {
+                startSample -= size1;
+            }
+
+            if (numSamples > 0)
+                std::memcpy(dest, data2 + startSample, sizeof(float) * (size_t)numSamples);
+        }
+    };
+
+    //tylko gdy żaden wątek nie zapisuje ani nie czyta
+    void prepare(int minimumCapacity)
+    {
+        capacity = juce::nextPowerOfTwo(juce::jmax(1, minimumCapacity));
+        mask = (uint32_t)capacity - 1;
+        samples.assign((size_t)capacity, 0.f);
+        reset();
+    }
+
+    void release()
+    {
+        std::vector<float>().swap(samples);
+        capacity = 0;
+        mask = 0;
+        reset();
+    }
+
+    void reset()
+    {
+        writeIndex.store(0);
+        readIndex.store(0);
+        droppedSamples.store(0);
+    }
+
+    //wątek zapisujący
+    void write(const float* source, int numSamples)
+    {
+        write(numSamples, [source](float* dest, int startSample, int count)
+        {
+            std::memcpy(dest, source + startSample, sizeof(float) * (size_t)count);
+        });
+    }
+
+    //jak write(), ale próbki wpisuje fill(dest, startSample, numSamples) wprost do pamięci pierścienia
+    //(jeden lub dwa fragmenty) - np. z rampą wzmocnienia zamiast osobnej kopii
+    template<typename Fill>
+    void write(int numSamples, Fill&& fill)
+    {
+        const auto w = writeIndex.load(std::memory_order_relaxed);
+        const auto r = readIndex.load(std::memory_order_acquire);
+        const auto freeSpace = (uint32_t)capacity - (w - r);
+        const auto toWrite = (uint32_t)juce::jmax(0, juce::jmin(numSamples, (int)freeSpace));
+
+        if (toWrite < (uint32_t)numSamples)
+            droppedSamples.fetch_add((uint32_t)numSamples - toWrite, std::memory_order_relaxed);
+
+        if (toWrite == 0)
+            return;
+
+        const auto start = w & mask;
+        const auto n1 = juce::jmin(toWrite, (uint32_t)capacity - start);
+        fill(samples.data() + start, 0, (int)n1);
+        if (toWrite > n1)
+            fill(samples.data(), (int)n1, (int)(toWrite - n1));
+
+        writeIndex.store(w + toWrite, std::memory_order_release);
+    }
+
+    //wątek czytający
+    int getNumReady() const
+    {
+        return (int)(writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_relaxed));
+    }
+
+    ReadView getReadView(int maxSamples) const
+    {
+        ReadView view;
+        const auto n = (uint32_t)juce::jmax(0, juce::jmin(maxSamples, getNumReady()));
+        if (n == 0)
+            return view;
+
+        const auto start = readIndex.load(std::memory_order_relaxed) & mask;
+        const auto n1 = juce::jmin(n, (uint32_t)capacity - start);
+        view.data1 = samples.data() + start;
+        view.size1 = (int)n1;
+        view.data2 = samples.data();
+        view.size2 = (int)(n - n1);
+        return view;
+    }
+
+    void finishedRead(int numSamples)
+    {
+        jassert(numSamples >= 0 && numSamples <= getNumReady());
+        readIndex.store(readIndex.load(std::memory_order_relaxed) + (uint32_t)numSamples, std::memory_order_release);
+    }
+
+    int getCapacity() const { return capacity; }
+    uint32_t getNumDroppedSamples() const { return droppedSamples.load(std::memory_order_relaxed); }
+private:
+    std::vector<float> samples;
+    int capacity = 0;
+    uint32_t mask = 0;
+    std::atomic<uint32_t> writeIndex{ 0 }, readIndex{ 0 };
+    std::atomic<uint32_t> droppedSamples{ 0 };
+};
+
 enum Channel
 {
     Right, //effectively 0
     Left //effectively 1
 };
 
+//jeden kanał bloku audio do analizatora; czytający dostaje próbki porcjami po getSize()
+//czytający trzyma getReadLock() na czas odczytu, prepare() i release() czekają na jego koniec
 template<typename BlockType>
 struct SingleChannelSampleFifo
 {
@@ -92,56 +256,69 @@ struct SingleChannelSampleFifo
     {
         jassert(prepared.get());
         jassert(buffer.getNumChannels() > channelToUse);
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        ring.write(buffer.getReadPointer(channelToUse), buffer.getNumSamples());
+    }
 
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+    //jak update(), ale próbki liczy fill(dest, channel, startSample, numSamples)
+    template<typename Fill>
+    void update(int numSamples, Fill&& fill)
+    {
+        jassert(prepared.get());
+        ring.write(numSamples, [this, &fill](float* dest, int startSample, int count)
         {
-            pushNextSampleIntoFifo(channelPtr[i]);
-        }
+            fill(dest, (int)channelToUse, startSample, count);
+        });
     }
 
     void prepare(int bufferSize)
     {
+        const juce::ScopedLock lock(readLock);
         prepared.set(false);
         size.set(bufferSize);
-
-        bufferToFill.setSize(1,             //channel
-            bufferSize,    //num samples
-            false,         //keepExistingContent
-            true,          //clear extra space
-            true);         //avoid reallocating
-        audioBufferFifo.prepare(1, bufferSize);
-        fifoIndex = 0;
+        //zapas jak dawniej: numBuffersOfHeadroom bloków
+        ring.prepare(bufferSize * numBuffersOfHeadroom);
         prepared.set(true);
     }
+
+    //zwalnia pamięć pierścienia - tylko gdy wątek audio na pewno już nie wywołuje update()
+    void release()
+    {
+        const juce::ScopedLock lock(readLock);
+        prepared.set(false);
+        size.set(0);
+        ring.release();
+    }
     //==============================================================================
-    int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
+    int getNumCompleteBuffersAvailable() const { return size.get() > 0 ? ring.getNumReady() / size.get() : 0; }
+    int getNumSamplesAvailable() const { return ring.getNumReady(); }
     bool isPrepared() const { return prepared.get(); }
     int getSize() const { return size.get(); }
+    uint32_t getNumDroppedSamples() const { return ring.getNumDroppedSamples(); }
     //==============================================================================
-    bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
+    SampleRingBuffer::ReadView getReadView(int maxSamples) const { return ring.getReadView(maxSamples); }
+    void finishedRead(int numSamples) { ring.finishedRead(numSamples); }
+    //wątek czytający: ScopedTryLock - przy nieudanej próbie pierścień jest właśnie przebudowywany
+    const juce::CriticalSection& getReadLock() const { return readLock; }
 private:
+    static constexpr int numBuffersOfHeadroom = 32;
+
     Channel channelToUse;
-    int fifoIndex = 0;
-    Fifo<BlockType> audioBufferFifo;
-    BlockType bufferToFill;
+    SampleRingBuffer ring;
+    juce::CriticalSection readLock;
     juce::Atomic<bool> prepared = false;
     juce::Atomic<int> size = 0;
+};
 
-    void pushNextSampleIntoFifo(float sample)
-    {
-        if (fifoIndex == bufferToFill.getNumSamples())
-        {
-            auto ok = audioBufferFifo.push(bufferToFill);
-
-            juce::ignoreUnused(ok);
-
-            fifoIndex = 0;
-        }
-
-        bufferToFill.setSample(0, fifoIndex, sample);
-        ++fifoIndex;
-    }
+//punkty odczytu analizatora: wejście, każde pasmo po kompresji, wyjście
+enum class AnalyzerTap
+{
+    pre,
+    low,
+    lowMid,
+    highMid,
+    high,
+    post,
+    numTaps
 };
 
 
@@ -153,6 +330,7 @@ namespace Parameters
 		Low_LowMid_Crossover_Freq, 
 		LowMid_HighMid_Crossover_Freq,
 		HighMid_High_Crossover_Freq,
+		Crossover_Slope,
 
 		Threshold_Low,
 		Threshold_LowMid,
@@ -194,8 +372,58 @@ namespace Parameters
 		Knee_HighMid,
 		Knee_High,
 
+		Auto_Release_Low,
+		Auto_Release_LowMid,
+		Auto_Release_HighMid,
+		Auto_Release_High,
+
+		Stereo_Link_Low,
+		Stereo_Link_LowMid,
+		Stereo_Link_HighMid,
+		Stereo_Link_High,
+
+		Detector_Low,
+		Detector_LowMid,
+		Detector_HighMid,
+		Detector_High,
+
+		Expander_Threshold_Low,
+		Expander_Threshold_LowMid,
+		Expander_Threshold_HighMid,
+		Expander_Threshold_High,
+
+		Expander_Ratio_Low,
+		Expander_Ratio_LowMid,
+		Expander_Ratio_HighMid,
+		Expander_Ratio_High,
+
+		Upward_Threshold_Low,
+		Upward_Threshold_LowMid,
+		Upward_Threshold_HighMid,
+		Upward_Threshold_High,
+
+		Upward_Ratio_Low,
+		Upward_Ratio_LowMid,
+		Upward_Ratio_HighMid,
+		Upward_Ratio_High,
+
+		Auto_Makeup_Low,
+		Auto_Makeup_LowMid,
+		Auto_Makeup_HighMid,
+		Auto_Makeup_High,
+
+		Mix_Low,
+		Mix_LowMid,
+		Mix_HighMid,
+		Mix_High,
+
 		Input_Gain,
 		Output_Gain,
+		Global_Mix,
+
+		Limiter_Enabled,
+		Limiter_Ceiling,
+		Limiter_Release,
 	};
 
 
@@ -206,6 +434,7 @@ namespace Parameters
 			{Low_LowMid_Crossover_Freq, "Low-LowMid Crossover (Hz)"},
 			{LowMid_HighMid_Crossover_Freq, "LowMid-HighMid Crossover (Hz)"},
 			{HighMid_High_Crossover_Freq, "HighMid-High Crossover (Hz)"},
+			{Crossover_Slope, "Crossover Slope"},
 
 			{Threshold_Low, "Threshold Low (dB)"},
 			{Threshold_LowMid, "Threshold LowMid (dB)"},
@@ -247,14 +476,907 @@ namespace Parameters
 			{Knee_HighMid, "Knee HighMid"},
 			{Knee_High, "Knee High"},
 
+			{Auto_Release_Low, "Auto Release Low"},
+			{Auto_Release_LowMid, "Auto Release LowMid"},
+			{Auto_Release_HighMid, "Auto Release HighMid"},
+			{Auto_Release_High, "Auto Release High"},
+
+			{Stereo_Link_Low, "Stereo Link Low"},
+			{Stereo_Link_LowMid, "Stereo Link LowMid"},
+			{Stereo_Link_HighMid, "Stereo Link HighMid"},
+			{Stereo_Link_High, "Stereo Link High"},
+
+			{Detector_Low, "Detector Low"},
+			{Detector_LowMid, "Detector LowMid"},
+			{Detector_HighMid, "Detector HighMid"},
+			{Detector_High, "Detector High"},
+
+			{Expander_Threshold_Low, "Expander Threshold Low (dB)"},
+			{Expander_Threshold_LowMid, "Expander Threshold LowMid (dB)"},
+			{Expander_Threshold_HighMid, "Expander Threshold HighMid (dB)"},
+			{Expander_Threshold_High, "Expander Threshold High (dB)"},
+
+			{Expander_Ratio_Low, "Expander Ratio Low"},
+			{Expander_Ratio_LowMid, "Expander Ratio LowMid"},
+			{Expander_Ratio_HighMid, "Expander Ratio HighMid"},
+			{Expander_Ratio_High, "Expander Ratio High"},
+
+			{Upward_Threshold_Low, "Upward Threshold Low (dB)"},
+			{Upward_Threshold_LowMid, "Upward Threshold LowMid (dB)"},
+			{Upward_Threshold_HighMid, "Upward Threshold HighMid (dB)"},
+			{Upward_Threshold_High, "Upward Threshold High (dB)"},
+
+			{Upward_Ratio_Low, "Upward Ratio Low"},
+			{Upward_Ratio_LowMid, "Upward Ratio LowMid"},
+			{Upward_Ratio_HighMid, "Upward Ratio HighMid"},
+			{Upward_Ratio_High, "Upward Ratio High"},
+
+			{Auto_Makeup_Low, "Auto Makeup Low"},
+			{Auto_Makeup_LowMid, "Auto Makeup LowMid"},
+			{Auto_Makeup_HighMid, "Auto Makeup HighMid"},
+			{Auto_Makeup_High, "Auto Makeup High"},
+
+			{Mix_Low, "Mix Low (%)"},
+			{Mix_LowMid, "Mix LowMid (%)"},
+			{Mix_HighMid, "Mix HighMid (%)"},
+			{Mix_High, "Mix High (%)"},
+
 			{Input_Gain,"Input Gain (dB)"},
 			{Output_Gain,"Output Gain (dB)"},
+			{Global_Mix,"Global Mix (%)"},
+
+			{Limiter_Enabled,"Limiter"},
+			{Limiter_Ceiling,"Limiter Ceiling (dB)"},
+			{Limiter_Release,"Limiter Release (ms)"},
 
 		};
 		return parameters;
 	}
+
+	//pozycje listy wyboru Crossover_Slope - ta sama kolejność co w GetCrossoverSlopeChoices()
+	enum class CrossoverSlope
+	{
+		db12PerOct,
+		db24PerOct,
+		db48PerOct
+	};
+
+	inline juce::StringArray GetCrossoverSlopeChoices()
+	{
+		return { "12 dB/oct", "24 dB/oct", "48 dB/oct" };
+	}
 }
 
+//filtry Linkwitza-Rileya o nachyleniu ustalonym w czasie kompilacji
+//LR(2B) = kwadrat filtru Butterwortha rzędu B, sekcje TPT jak w juce::dsp::LinkwitzRileyFilter
+template<int Order>
+struct LinkwitzRileyTraits;
+
+//12 dB/okt - dwie sekcje 1. rzędu
+template<>
+struct LinkwitzRileyTraits<2>
+{
+    static constexpr int sectionOrder = 1;
+    static constexpr int numSections = 2;
+    //LR2: górnoprzepustowy w przeciwfazie, inaczej suma pasm ma dziurę na częstotliwości podziału
+    static constexpr float highpassPolarity = -1.f;
+    static constexpr std::array<float, numSections> damping{ 0.f, 0.f };
+};
+
+//24 dB/okt - odpowiednik juce::dsp::LinkwitzRileyFilter
+template<>
+struct LinkwitzRileyTraits<4>
+{
+    static constexpr int sectionOrder = 2;
+    static constexpr int numSections = 2;
+    static constexpr float highpassPolarity = 1.f;
+    static constexpr std::array<float, numSections> damping{ 1.41421356f, 1.41421356f };
+};
+
+//48 dB/okt - Butterworth 4. rzędu (Q = 0.541, 1.307) dwa razy
+template<>
+struct LinkwitzRileyTraits<8>
+{
+    static constexpr int sectionOrder = 2;
+    static constexpr int numSections = 4;
+    static constexpr float highpassPolarity = 1.f;
+    static constexpr std::array<float, numSections> damping{ 1.84775907f, 0.76536686f, 1.84775907f, 0.76536686f };
+};
+
+template<int Order>
+class LinkwitzRileyFilter
+{
+public:
+    using Traits = LinkwitzRileyTraits<Order>;
+    using Type = juce::dsp::LinkwitzRileyFilterType;
+
+    void setType(Type newType) { type = newType; }
+
+    void setCutoffFrequency(float newCutoffFrequency)
+    {
+        if (cutoffFrequency != newCutoffFrequency)
+        {
+            cutoffFrequency = newCutoffFrequency;
+            update();
+        }
+    }
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        state.resize(spec.numChannels);
+        update();
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& s : state)
+            s.fill(0.f);
+    }
+
+    template<typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = juce::jmin(outputBlock.getNumChannels(), state.size());
+        const auto numSamples = outputBlock.getNumSamples();
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(inputBlock);
+            return;
+        }
+
+        //typ wybierany raz na blok, pętla po próbkach bez rozgałęzień
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto* input = inputBlock.getChannelPointer(ch);
+            auto* output = outputBlock.getChannelPointer(ch);
+
+            switch (type)
+            {
+                case Type::lowpass:  processChannel<Type::lowpass>(input, output, numSamples, state[ch]); break;
+                case Type::highpass: processChannel<Type::highpass>(input, output, numSamples, state[ch]); break;
+                case Type::allpass:  processChannel<Type::allpass>(input, output, numSamples, state[ch]); break;
+            }
+        }
+    }
+
+private:
+    static constexpr int numStates = Traits::numSections * Traits::sectionOrder;
+    using ChannelState = std::array<float, numStates>;
+
+    Type type = Type::lowpass;
+    double sampleRate = 44100.0;
+    float cutoffFrequency = 2000.f;
+
+    float g = 0.f, firstOrderGain = 0.f;
+    std::array<float, Traits::numSections> secondOrderGain{};
+    std::vector<ChannelState> state;
+
+    void update()
+    {
+        g = static_cast<float>(std::tan(juce::MathConstants<double>::pi * cutoffFrequency / sampleRate));
+        firstOrderGain = g / (1.f + g);
+        for (size_t i = 0; i < secondOrderGain.size(); ++i)
+            secondOrderGain[i] = 1.f / (1.f + Traits::damping[i] * g + g * g);
+    }
+
+    template<Type FilterType>
+    void processChannel(const float* input, float* output, size_t numSamples, ChannelState& s) const noexcept
+    {
+        for (size_t n = 0; n < numSamples; ++n)
+            output[n] = processSample<FilterType>(input[n], s);
+    }
+
+    template<Type FilterType>
+    float processSample(float x, ChannelState& s) const noexcept
+    {
+        //liczba sekcji jest stałą - kompilator rozwija pętle
+        if constexpr (FilterType == Type::allpass)
+        {
+            //LP + HP filtru LR(2B) to wszechprzepustowy Butterwortha rzędu B - połowa sekcji
+            for (int i = 0; i < Traits::numSections / 2; ++i)
+                x = allpassSection(i, x, s);
+            return x;
+        }
+        else
+        {
+            for (int i = 0; i < Traits::numSections; ++i)
+                x = section<FilterType>(i, x, s);
+
+            if constexpr (FilterType == Type::highpass)
+                return Traits::highpassPolarity * x;
+            else
+                return x;
+        }
+    }
+
+    template<Type FilterType>
+    float section(int i, float x, ChannelState& s) const noexcept
+    {
+        if constexpr (Traits::sectionOrder == 1)
+        {
+            auto v = (x - s[(size_t)i]) * firstOrderGain;
+            auto yL = v + s[(size_t)i];
+            s[(size_t)i] = yL + v;
+            return FilterType == Type::lowpass ? yL : x - yL;
+        }
+        else
+        {
+            auto& s1 = s[(size_t)(2 * i)];
+            auto& s2 = s[(size_t)(2 * i + 1)];
+            auto yH = (x - (Traits::damping[(size_t)i] + g) * s1 - s2) * secondOrderGain[(size_t)i];
+            auto yB = g * yH + s1;
+            s1 = g * yH + yB;
+            auto yL = g * yB + s2;
+            s2 = g * yB + yL;
+            return FilterType == Type::lowpass ? yL : yH;
+        }
+    }
+
+    float allpassSection(int i, float x, ChannelState& s) const noexcept
+    {
+        if constexpr (Traits::sectionOrder == 1)
+        {
+            auto v = (x - s[(size_t)i]) * firstOrderGain;
+            auto yL = v + s[(size_t)i];
+            s[(size_t)i] = yL + v;
+            //LP - HP = (1 - s) / (1 + s)
+            return 2.f * yL - x;
+        }
+        else
+        {
+            auto& s1 = s[(size_t)(2 * i)];
+            auto& s2 = s[(size_t)(2 * i + 1)];
+            auto yH = (x - (Traits::damping[(size_t)i] + g) * s1 - s2) * secondOrderGain[(size_t)i];
+            auto yB = g * yH + s1;
+            s1 = g * yH + yB;
+            auto yL = g * yB + s2;
+            s2 = g * yB + yL;
+            return yL - Traits::damping[(size_t)i] * yB + yH;
+        }
+    }
+};
+
+//sekcje wszechprzepustowe do wyrównania fazy pasm (LP + HP filtru LR(2B))
+//stan ułożony kanałami obok siebie - wewnętrzna pętla po kanałach jest wektoryzowana
+template<int Order>
+class LinkwitzRileyAllpass
+{
+public:
+    using Traits = LinkwitzRileyTraits<Order>;
+
+    void setCutoffFrequency(float newCutoffFrequency)
+    {
+        if (cutoffFrequency != newCutoffFrequency)
+        {
+            cutoffFrequency = newCutoffFrequency;
+            update();
+        }
+    }
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        numChannels = static_cast<size_t>(spec.numChannels);
+        state.assign(numStates * numChannels, 0.f);
+        update();
+    }
+
+    void reset()
+    {
+        std::fill(state.begin(), state.end(), 0.f);
+    }
+
+    void process(juce::dsp::AudioBlock<float>& block) noexcept
+    {
+        const auto channels = juce::jmin(block.getNumChannels(), numChannels);
+        const auto numSamples = block.getNumSamples();
+
+        //pary kanałów razem (stereo w jednym przebiegu), nieparzysty kanał osobno
+        size_t ch = 0;
+        for (; ch + 2 <= channels; ch += 2)
+            processLanes<2>(block, ch, numSamples);
+        for (; ch < channels; ++ch)
+            processLanes<1>(block, ch, numSamples);
+    }
+
+private:
+    //B/2 sekcji filtru Butterwortha rzędu B
+    static constexpr int numAllpassSections = Traits::numSections / 2;
+    static constexpr size_t numStates = static_cast<size_t>(numAllpassSections * Traits::sectionOrder);
+
+    double sampleRate = 44100.0;
+    float cutoffFrequency = 2000.f;
+    size_t numChannels = 0;
+
+    float g = 0.f, firstOrderGain = 0.f;
+    std::array<float, numAllpassSections> secondOrderGain{};
+    //state[i * numChannels + ch]
+    std::vector<float> state;
+
+    void update()
+    {
+        g = static_cast<float>(std::tan(juce::MathConstants<double>::pi * cutoffFrequency / sampleRate));
+        firstOrderGain = g / (1.f + g);
+        for (size_t i = 0; i < secondOrderGain.size(); ++i)
+            secondOrderGain[i] = 1.f / (1.f + Traits::damping[i] * g + g * g);
+    }
+
+    //Lanes kanałów przetwarzanych razem - stała czasu kompilacji, pętle po kanałach rozwinięte
+    template<size_t Lanes>
+    void processLanes(juce::dsp::AudioBlock<float>& block, size_t firstChannel, size_t numSamples) noexcept
+    {
+        std::array<float*, Lanes> data;
+        for (size_t ch = 0; ch < Lanes; ++ch)
+            data[ch] = block.getChannelPointer(firstChannel + ch);
+
+        auto* s = state.data() + firstChannel;
+        const auto stride = numChannels;
+
+        for (size_t n = 0; n < numSamples; ++n)
+        {
+            std::array<float, Lanes> x;
+            for (size_t ch = 0; ch < Lanes; ++ch)
+                x[ch] = data[ch][n];
+
+            for (int i = 0; i < numAllpassSections; ++i)
+            {
+                if constexpr (Traits::sectionOrder == 1)
+                {
+                    auto* s1 = s + (size_t)i * stride;
+                    for (size_t ch = 0; ch < Lanes; ++ch)
+                    {
+                        auto v = (x[ch] - s1[ch]) * firstOrderGain;
+                        auto yL = v + s1[ch];
+                        s1[ch] = yL + v;
+                        x[ch] = 2.f * yL - x[ch];
+                    }
+                }
+                else
+                {
+                    auto* s1 = s + (size_t)(2 * i) * stride;
+                    auto* s2 = s + (size_t)(2 * i + 1) * stride;
+                    const auto k = Traits::damping[(size_t)i];
+                    const auto h = secondOrderGain[(size_t)i];
+                    for (size_t ch = 0; ch < Lanes; ++ch)
+                    {
+                        auto yH = (x[ch] - (k + g) * s1[ch] - s2[ch]) * h;
+                        auto yB = g * yH + s1[ch];
+                        s1[ch] = g * yH + yB;
+                        auto yL = g * yB + s2[ch];
+                        s2[ch] = g * yB + yL;
+                        x[ch] = yL - k * yB + yH;
+                    }
+                }
+            }
+
+            for (size_t ch = 0; ch < Lanes; ++ch)
+                data[ch][n] = x[ch];
+        }
+    }
+};
+
+//drzewo podziału na 4 pasma dla jednego nachylenia
+template<int Order>
+struct CrossoverBandSplitter
+{
+    using Filter = LinkwitzRileyFilter<Order>;
+
+    CrossoverBandSplitter()
+    {
+        LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
+        LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
+        LP3.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
+        HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+        HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+        HP3.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+    }
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        LP1.prepare(spec);
+        LP2.prepare(spec);
+        LP3.prepare(spec);
+        HP1.prepare(spec);
+        HP2.prepare(spec);
+        HP3.prepare(spec);
+        AP1.prepare(spec);
+        AP3.prepare(spec);
+    }
+
+    void reset()
+    {
+        LP1.reset();
+        LP2.reset();
+        LP3.reset();
+        HP1.reset();
+        HP2.reset();
+        HP3.reset();
+        AP1.reset();
+        AP3.reset();
+    }
+
+    void setCutoffFrequencies(float lowLowMidCutoff, float lowMidHighMidCutoff, float highMidHighCutoff)
+    {
+        LP1.setCutoffFrequency(lowLowMidCutoff);
+        HP1.setCutoffFrequency(lowLowMidCutoff);
+
+        LP2.setCutoffFrequency(lowMidHighMidCutoff);
+        HP2.setCutoffFrequency(lowMidHighMidCutoff);
+
+        LP3.setCutoffFrequency(highMidHighCutoff);
+        HP3.setCutoffFrequency(highMidHighCutoff);
+
+        //dolna połowa dostaje fazę podziału górnego, górna - fazę podziału dolnego
+        AP3.setCutoffFrequency(highMidHighCutoff);
+        AP1.setCutoffFrequency(lowLowMidCutoff);
+    }
+
+    void process(juce::AudioBuffer<float>& input, std::array<juce::AudioBuffer<float>, 4>& filterBuffers)
+    {
+        const auto numChannels = input.getNumChannels();
+        const auto numSamples = input.getNumSamples();
+
+        //bufory przygotowane w prepareToPlay - bez realokacji
+        for (auto& fb : filterBuffers)
+            fb.setSize(numChannels, numSamples, false, false, true);
+
+        auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
+        auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
+        auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
+        auto fb3Block = juce::dsp::AudioBlock<float>(filterBuffers[3]);
+        auto inputBlock = juce::dsp::AudioBlock<float>(input);
+
+        //LOW = LP2 + AP3 + LP1
+        //LOWMID = LP2 + AP3 + HP1
+        LP2.process(juce::dsp::ProcessContextNonReplacing<float>(inputBlock, fb1Block));
+        AP3.process(fb1Block);
+        LP1.process(juce::dsp::ProcessContextNonReplacing<float>(fb1Block, fb0Block));
+        HP1.process(juce::dsp::ProcessContextReplacing<float>(fb1Block));
+
+        //HIGHMID = HP2 + AP1 + LP3
+        //HIGH = HP2 + AP1 + HP3
+        //suma pasm = AP1 * AP2 * AP3 - płaska amplituda
+        HP2.process(juce::dsp::ProcessContextNonReplacing<float>(inputBlock, fb3Block));
+        AP1.process(fb3Block);
+        LP3.process(juce::dsp::ProcessContextNonReplacing<float>(fb3Block, fb2Block));
+        HP3.process(juce::dsp::ProcessContextReplacing<float>(fb3Block));
+    }
+
+private:
+    Filter LP1, LP2, LP3;
+    Filter HP1, HP2, HP3;
+    //kompensacja fazy: AP1 na częstotliwości LP1/HP1, AP3 na częstotliwości LP3/HP3
+    LinkwitzRileyAllpass<Order> AP1, AP3;
+};
+
+//charakterystyka dynamiki pasma: kompresja w dół, kompresja w górę i ekspansja w dół (suma w dB)
+//liczona do tablicy przy zmianie parametrów, w pętli próbek tylko odczyt z interpolacją liniową
+//indeks z bitów float (wykładnik + mantysa) - bez log10 i exp na próbkę
+class DynamicsTransferCurve
+{
+public:
+    void setThreshold(float newThresholdDb) { setIfChanged(thresholdDb, newThresholdDb); }
+    void setRatio(float newRatio) { setIfChanged(ratio, juce::jmax(1.f, newRatio)); }
+    //kolano 0..1 -> szerokość 0..maxKneeWidthDb, wspólne dla wszystkich progów
+    void setKnee(float newKnee) { setIfChanged(knee, juce::jlimit(0.f, 1.f, newKnee)); }
+    void setExpanderThreshold(float newThresholdDb) { setIfChanged(expanderThresholdDb, newThresholdDb); }
+    void setExpanderRatio(float newRatio) { setIfChanged(expanderRatio, juce::jmax(1.f, newRatio)); }
+    void setUpwardThreshold(float newThresholdDb) { setIfChanged(upwardThresholdDb, newThresholdDb); }
+    void setUpwardRatio(float newRatio) { setIfChanged(upwardRatio, juce::jmax(1.f, newRatio)); }
+
+    //wywoływane raz na blok - przelicza tablicę tylko po zmianie parametrów
+    void update()
+    {
+        if (!needsUpdate)
+            return;
+
+        needsUpdate = false;
+
+        //auto makeup: odwrotność redukcji kompresji w dół dla sygnału 0 dBFS (z kolanem)
+        auto kneeWidthDb = juce::jmax(minKneeWidthDb, knee * maxKneeWidthDb);
+        makeupGainDb = (1.f - 1.f / ratio) * softPositivePart(-thresholdDb, kneeWidthDb);
+        makeupGain = juce::Decibels::decibelsToGain(makeupGainDb);
+
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            //punkt tablicy leży dokładnie na siatce pseudoLog2
+            auto u = minLog2 + static_cast<float>(i) / static_cast<float>(pointsPerOctave);
+            auto exponent = std::floor(u);
+            auto level = std::ldexp(1.f + (u - exponent), static_cast<int>(exponent));
+            table[i] = juce::Decibels::decibelsToGain(computeGainDb(juce::Decibels::gainToDecibels(level)), minGainDb - 1.f);
+        }
+    }
+
+    float getMakeupGain() const noexcept { return makeupGain; }
+    float getMakeupGainDb() const noexcept { return makeupGainDb; }
+
+    float getGain(float envelope) const noexcept
+    {
+        auto index = (pseudoLog2(juce::jlimit(minLevel, maxLevel, envelope)) - minLog2) * static_cast<float>(pointsPerOctave);
+        auto i = juce::jmin(static_cast<int>(index), numSegments - 1);
+        auto frac = index - static_cast<float>(i);
+        return table[(size_t)i] + frac * (table[(size_t)i + 1] - table[(size_t)i]);
+    }
+
+    float computeGainDb(float levelDb) const noexcept
+    {
+        auto kneeWidthDb = juce::jmax(minKneeWidthDb, knee * maxKneeWidthDb);
+
+        auto downward = (1.f / ratio - 1.f) * softPositivePart(levelDb - thresholdDb, kneeWidthDb);
+        auto upward = (1.f - 1.f / upwardRatio) * softPositivePart(upwardThresholdDb - levelDb, kneeWidthDb);
+        auto expansion = (1.f - expanderRatio) * softPositivePart(expanderThresholdDb - levelDb, kneeWidthDb);
+
+        return juce::jmax(minGainDb, downward + juce::jmin(upward, maxUpwardGainDb) + expansion);
+    }
+
+private:
+    static constexpr float maxKneeWidthDb = 12.f;
+    static constexpr float minKneeWidthDb = 1.0e-3f;
+    static constexpr float maxUpwardGainDb = 24.f;
+    static constexpr float minGainDb = -96.f;
+
+    //zakres tablicy: 2^-16 (~ -96 dBFS) .. 2^4 (~ +24 dBFS), 16 punktów na oktawę
+    static constexpr float minLog2 = -16.f;
+    static constexpr float maxLog2 = 4.f;
+    static constexpr int pointsPerOctave = 16;
+    static constexpr int numSegments = static_cast<int>(maxLog2 - minLog2) * pointsPerOctave;
+    static constexpr float minLevel = 1.f / 65536.f;
+    static constexpr float maxLevel = 15.99f;
+
+    float thresholdDb = 0.f, ratio = 1.f, knee = 0.f;
+    float expanderThresholdDb = -96.f, expanderRatio = 1.f;
+    float upwardThresholdDb = -96.f, upwardRatio = 1.f;
+    bool needsUpdate = true;
+    float makeupGainDb = 0.f, makeupGain = 1.f;
+
+    std::array<float, numSegments + 1> table{};
+
+    void setIfChanged(float& value, float newValue)
+    {
+        if (value != newValue)
+        {
+            value = newValue;
+            needsUpdate = true;
+        }
+    }
+
+    //wykładnik + mantysa: dokładne na potęgach 2, liniowe w amplitudzie pomiędzy
+    static float pseudoLog2(float x) noexcept
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return static_cast<float>(bits) * (1.f / 8388608.f) - 127.f;
+    }
+
+    //gładkie max(0, x): kwadratowe przejście w [-W/2, W/2]
+    static float softPositivePart(float x, float kneeWidthDb) noexcept
+    {
+        auto halfKnee = 0.5f * kneeWidthDb;
+        auto inKnee = juce::jlimit(0.f, kneeWidthDb, x + halfKnee);
+        return inKnee * inKnee / (2.f * kneeWidthDb) + juce::jmax(0.f, x - halfKnee);
+    }
+};
+
+//kompresor jednego pasma - zastępuje juce::dsp::Compressor
+//detekcja szczytowa jak juce::dsp::BallisticsFilter lub RMS (suma krocząca O(1)), charakterystyka z tablicy DynamicsTransferCurve
+//auto release: szybka obwiednia + wolna (jeden dodatkowy filtr 1. rzędu), łączone maksimum
+//tryby połączone (max/średnia kanałów) liczą jedną obwiednię i jedno wzmocnienie na pasmo
+class CompressorKernel
+{
+public:
+    enum class StereoLink
+    {
+        linkedMax,
+        linkedMean,
+        unlinked
+    };
+
+    enum class Detector
+    {
+        peak,
+        rms
+    };
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        numChannels = static_cast<size_t>(spec.numChannels);
+        fastEnvelope.resize(numChannels);
+        slowEnvelope.resize(numChannels);
+
+        rmsWindowSize = static_cast<size_t>(juce::jmax(1, juce::roundToInt(sampleRate * rmsWindowSeconds)));
+        rmsHistory.resize(numChannels * rmsWindowSize);
+        rmsSum.resize(numChannels);
+        rmsPosition.resize(numChannels);
+        inverseRmsWindowSize = 1.f / static_cast<float>(rmsWindowSize);
+
+        updateTimeConstants();
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(fastEnvelope.begin(), fastEnvelope.end(), 0.f);
+        std::fill(slowEnvelope.begin(), slowEnvelope.end(), 0.f);
+        std::fill(rmsHistory.begin(), rmsHistory.end(), 0.f);
+        std::fill(rmsSum.begin(), rmsSum.end(), 0.0);
+        std::fill(rmsPosition.begin(), rmsPosition.end(), size_t(0));
+    }
+
+    void setAttack(float newAttackMs) { setIfChanged(attackMs, newAttackMs); }
+    void setRelease(float newReleaseMs) { setIfChanged(releaseMs, newReleaseMs); }
+
+    void setAutoRelease(bool shouldUseAutoRelease)
+    {
+        if (autoRelease != shouldUseAutoRelease)
+        {
+            autoRelease = shouldUseAutoRelease;
+            updateTimeConstants();
+        }
+    }
+
+    void setStereoLink(StereoLink newLink) { link = newLink; }
+
+    void setDetector(Detector newDetector)
+    {
+        //okno RMS startuje od zera - bez skoku poziomu z poprzedniego trybu
+        if (detector != newDetector)
+        {
+            detector = newDetector;
+            std::fill(rmsHistory.begin(), rmsHistory.end(), 0.f);
+            std::fill(rmsSum.begin(), rmsSum.end(), 0.0);
+        }
+    }
+
+    DynamicsTransferCurve& getTransferCurve() { return curve; }
+
+    //rzeczywista redukcja wzmocnienia z ostatniego bloku (dB, <= 0 dla kompresji)
+    //największa (najmniejsze wzmocnienie) i średnia z wartości na próbkę
+    float getGainReductionMaxDb() const noexcept { return gainReductionMaxDb; }
+    float getGainReductionMeanDb() const noexcept { return gainReductionMeanDb; }
+    //najmniejsza redukcja w bloku (największe wzmocnienie)
+    float getGainReductionMinDb() const noexcept { return gainReductionMinDb; }
+
+    template<typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+
+        blockMinGain = 1.f;
+        blockMaxGain = 0.f;
+        blockGainSum = 0.f;
+        blockGainCount = 0;
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(inputBlock);
+            updateGainReduction();
+            return;
+        }
+
+        curve.update();
+
+        //tryb wybierany raz na blok - pętle po próbkach specjalizowane, bez rozgałęzień
+        if (detector == Detector::rms)
+            processWithLink<Detector::rms>(inputBlock, outputBlock);
+        else
+            processWithLink<Detector::peak>(inputBlock, outputBlock);
+
+        updateGainReduction();
+    }
+
+private:
+    //w trybie auto szybki release = release / autoReleaseRatio, wolny = release
+    static constexpr float autoReleaseRatio = 10.f;
+    static constexpr double rmsWindowSeconds = 0.01;
+
+    double sampleRate = 44100.0;
+    size_t numChannels = 0;
+    float attackMs = 50.f, releaseMs = 250.f;
+    bool autoRelease = false;
+    StereoLink link = StereoLink::linkedMax;
+    Detector detector = Detector::peak;
+
+    float cteAttack = 0.f, cteRelease = 0.f, cteSlow = 0.f, slowWeight = 0.f;
+
+    DynamicsTransferCurve curve;
+
+    //redukcja per blok: min i suma wzmocnień liczone w pętli próbek (min + dodawanie na próbkę)
+    float blockMinGain = 1.f, blockMaxGain = 0.f, blockGainSum = 0.f;
+    size_t blockGainCount = 0;
+    float gainReductionMaxDb = 0.f, gainReductionMeanDb = 0.f, gainReductionMinDb = 0.f;
+
+    void updateGainReduction() noexcept
+    {
+        auto hasSamples = blockGainCount > 0;
+        auto meanGain = hasSamples ? blockGainSum / static_cast<float>(blockGainCount) : 1.f;
+        gainReductionMaxDb = juce::Decibels::gainToDecibels(blockMinGain, -96.f);
+        gainReductionMeanDb = juce::Decibels::gainToDecibels(meanGain, -96.f);
+        gainReductionMinDb = juce::Decibels::gainToDecibels(hasSamples ? blockMaxGain : 1.f, -96.f);
+    }
+
+    std::vector<float> fastEnvelope, slowEnvelope;
+
+    //RMS: kwadraty ostatnich rmsWindowSize próbek i ich suma (double - bez dryfu)
+    size_t rmsWindowSize = 1;
+    float inverseRmsWindowSize = 1.f;
+    std::vector<float> rmsHistory;
+    std::vector<double> rmsSum;
+    std::vector<size_t> rmsPosition;
+
+    void setIfChanged(float& value, float newValue)
+    {
+        if (value != newValue)
+        {
+            value = newValue;
+            updateTimeConstants();
+        }
+    }
+
+    //jak juce::dsp::BallisticsFilter - czas do 1 - 1/e^(2pi) wartości docelowej
+    float calculateCte(float timeMs) const
+    {
+        return timeMs < 1.0e-3f ? 0.f
+                                : static_cast<float>(std::exp(-2.0 * juce::MathConstants<double>::pi * 1000.0 / (timeMs * sampleRate)));
+    }
+
+    void updateTimeConstants()
+    {
+        cteAttack = calculateCte(attackMs);
+        cteRelease = calculateCte(autoRelease ? releaseMs / autoReleaseRatio : releaseMs);
+        cteSlow = calculateCte(releaseMs);
+        slowWeight = autoRelease ? 1.f : 0.f;
+    }
+
+    template<Detector DetectorType, typename InputBlock>
+    void processWithLink(const InputBlock& inputBlock, juce::dsp::AudioBlock<float>& outputBlock) noexcept
+    {
+        switch (link)
+        {
+            case StereoLink::linkedMax:  processLinked<DetectorType, StereoLink::linkedMax>(inputBlock, outputBlock); break;
+            case StereoLink::linkedMean: processLinked<DetectorType, StereoLink::linkedMean>(inputBlock, outputBlock); break;
+            case StereoLink::unlinked:   processUnlinked<DetectorType>(inputBlock, outputBlock); break;
+        }
+    }
+
+    template<Detector DetectorType, typename InputBlock>
+    void processUnlinked(const InputBlock& inputBlock, juce::dsp::AudioBlock<float>& outputBlock) noexcept
+    {
+        const auto channels = juce::jmin(outputBlock.getNumChannels(), numChannels);
+        const auto numSamples = outputBlock.getNumSamples();
+
+        for (size_t ch = 0; ch < channels; ++ch)
+        {
+            auto* input = inputBlock.getChannelPointer(ch);
+            auto* output = outputBlock.getChannelPointer(ch);
+            auto fast = fastEnvelope[ch];
+            auto slow = slowEnvelope[ch];
+            auto minGain = blockMinGain;
+            auto maxGain = blockMaxGain;
+            auto gainSum = 0.f;
+
+            for (size_t n = 0; n < numSamples; ++n)
+            {
+                auto envelope = followEnvelope(detect<DetectorType>(ch, input[n]), fast, slow);
+                auto gain = computeGain(envelope);
+                minGain = juce::jmin(minGain, gain);
+                maxGain = juce::jmax(maxGain, gain);
+                gainSum += gain;
+                output[n] = input[n] * gain;
+            }
+
+            fastEnvelope[ch] = fast;
+            slowEnvelope[ch] = slow;
+            blockMinGain = minGain;
+            blockMaxGain = maxGain;
+            blockGainSum += gainSum;
+            blockGainCount += numSamples;
+        }
+    }
+
+    //jedna obwiednia i jedno wzmocnienie dla wszystkich kanałów (stan w kanale 0)
+    template<Detector DetectorType, StereoLink LinkType, typename InputBlock>
+    void processLinked(const InputBlock& inputBlock, juce::dsp::AudioBlock<float>& outputBlock) noexcept
+    {
+        const auto channels = juce::jmin(outputBlock.getNumChannels(), numChannels);
+        const auto numSamples = outputBlock.getNumSamples();
+
+        if (channels == 0)
+            return;
+
+        const auto inverseNumChannels = 1.f / static_cast<float>(channels);
+        auto fast = fastEnvelope[0];
+        auto slow = slowEnvelope[0];
+        auto minGain = blockMinGain;
+        auto maxGain = blockMaxGain;
+        auto gainSum = 0.f;
+
+        for (size_t n = 0; n < numSamples; ++n)
+        {
+            auto level = 0.f;
+            for (size_t ch = 0; ch < channels; ++ch)
+            {
+                auto x = detect<DetectorType>(ch, inputBlock.getChannelPointer(ch)[n]);
+                if constexpr (LinkType == StereoLink::linkedMax)
+                    level = juce::jmax(level, x);
+                else
+                    level += x;
+            }
+
+            if constexpr (LinkType == StereoLink::linkedMean)
+                level *= inverseNumChannels;
+
+            auto gain = computeGain(followEnvelope(level, fast, slow));
+            minGain = juce::jmin(minGain, gain);
+            maxGain = juce::jmax(maxGain, gain);
+            gainSum += gain;
+
+            for (size_t ch = 0; ch < channels; ++ch)
+                outputBlock.getChannelPointer(ch)[n] = inputBlock.getChannelPointer(ch)[n] * gain;
+        }
+
+        fastEnvelope[0] = fast;
+        slowEnvelope[0] = slow;
+        blockMinGain = minGain;
+        blockMaxGain = maxGain;
+        blockGainSum += gainSum;
+        blockGainCount += numSamples;
+    }
+
+    template<Detector DetectorType>
+    float detect(size_t ch, float x) noexcept
+    {
+        if constexpr (DetectorType == Detector::peak)
+        {
+            return std::abs(x);
+        }
+        else
+        {
+            //suma krocząca: dodaj nowy kwadrat, odejmij najstarszy
+            auto& position = rmsPosition[ch];
+            auto& oldest = rmsHistory[ch * rmsWindowSize + position];
+            auto square = x * x;
+            rmsSum[ch] += static_cast<double>(square) - static_cast<double>(oldest);
+            oldest = square;
+            position = position + 1 == rmsWindowSize ? 0 : position + 1;
+            return std::sqrt(juce::jmax(0.f, static_cast<float>(rmsSum[ch]) * inverseRmsWindowSize));
+        }
+    }
+
+    //bez rozgałęzień: wybór stałej czasowej to select, auto release włączany wagą 0/1
+    float followEnvelope(float x, float& fast, float& slow) const noexcept
+    {
+        auto cte = x > fast ? cteAttack : cteRelease;
+        fast = x + cte * (fast - x);
+        slow = fast + cteSlow * (slow - fast);
+        return juce::jmax(fast, slowWeight * slow);
+    }
+
+    float computeGain(float envelope) const noexcept
+    {
+        return curve.getGain(envelope);
+    }
+};
+
+//poziomy jednego pasma z ostatniego bloku
+struct BandMeterValues
+{
+    float inputRmsDb = -48.f;
+    float outputRmsDb = -48.f;
+    float outputPeakDb = -48.f;
+    float gainReductionMaxDb = 0.f;
+    float gainReductionMeanDb = 0.f;
+    float gainReductionMinDb = 0.f;
+};
+
 struct CompressorBand 
 {
     juce::AudioParameterFloat* attack{ nullptr };
@@ -265,23 +1387,84 @@ struct CompressorBand
     juce::AudioParameterBool* mute{ nullptr };
     juce::AudioParameterBool* solo{ nullptr };
     juce::AudioParameterFloat* knee{ nullptr };
+    juce::AudioParameterFloat* mix{ nullptr };
+    juce::AudioParameterBool* autoRelease{ nullptr };
+    juce::AudioParameterChoice* stereoLink{ nullptr };
+    juce::AudioParameterChoice* detector{ nullptr };
+    juce::AudioParameterFloat* expanderThreshold{ nullptr };
+    juce::AudioParameterFloat* expanderRatio{ nullptr };
+    juce::AudioParameterFloat* upwardThreshold{ nullptr };
+    juce::AudioParameterFloat* upwardRatio{ nullptr };
+    juce::AudioParameterBool* autoMakeup{ nullptr };
+
+    //wzmocnienie na początku i końcu bloku (rampa liniowa) - udział sygnału mokrego, makeup
+    struct GainRamp
+    {
+        float start = 1.f;
+        float end = 1.f;
+    };
 
     void prepare(const juce::dsp::ProcessSpec& spec)
     {
         compressor.prepare(spec);
+
+        //bufor sygnału suchego alokowany raz, nigdy w processBlock
+        dryBuffer.setSize(static_cast<int>(spec.numChannels),
+            static_cast<int>(spec.maximumBlockSize),
+            false,
+            true,
+            true);
+        dryBuffer.clear();
+
+        dryDelay.setMaximumDelayInSamples(juce::jmax(1, static_cast<int>(spec.sampleRate * maxDryDelaySeconds)));
+        dryDelay.prepare(spec);
+
+        wetGain = { 1.f, 1.f };
+        makeupGain = { 1.f, 1.f };
+    }
+
+    //opóźnienie toru suchego = latencja toru mokrego (lookahead, oversampling)
+    void setDryDelay(int numSamples)
+    {
+        dryDelaySamples = juce::jlimit(0, dryDelay.getMaximumDelayInSamples(), numSamples);
+        dryDelay.setDelay(static_cast<float>(dryDelaySamples));
+        dryDelay.reset();
     }
 
     void updateCompressorSettings()
     {
         compressor.setAttack(attack->get());
         compressor.setRelease(release->get());
-        compressor.setThreshold(threshold->get());
-        compressor.setRatio(ratio->get());
-		compressor.setKnee(knee->get());
+        auto& curve = compressor.getTransferCurve();
+        curve.setThreshold(threshold->get());
+        curve.setRatio(ratio->get());
+        curve.setKnee(knee->get());
+        curve.setExpanderThreshold(expanderThreshold->get());
+        curve.setExpanderRatio(expanderRatio->get());
+        curve.setUpwardThreshold(upwardThreshold->get());
+        curve.setUpwardRatio(upwardRatio->get());
+        compressor.setAutoRelease(autoRelease->get());
+        //kolejność wyborów parametrów = kolejność enumów
+        compressor.setStereoLink(static_cast<CompressorKernel::StereoLink>(stereoLink->getIndex()));
+        compressor.setDetector(static_cast<CompressorKernel::Detector>(detector->getIndex()));
+        //tablica i makeup przeliczane tylko po zmianie progu, ratio lub kolana
+        curve.update();
     }
 
-    void process(juce::AudioBuffer<float>& buffer)
+    void process(juce::AudioBuffer<float>& buffer, float globalMix)
     {
+        wetGain.start = wetGain.end;
+        wetGain.end = mix->get() * 0.01f * globalMix;
+
+        //makeup stosowany przy sumowaniu pasm (addFilterBand), bez osobnego przejścia po buforze
+        makeupGain.start = makeupGain.end;
+        makeupGain.end = autoMakeup->get() && !bypassed->get() ? compressor.getTransferCurve().getMakeupGain() : 1.f;
+
+        //kopia sucha tylko gdy miks jest faktycznie używany
+        //(z opóźnieniem linia musi być karmiona ciągle)
+        if (needsDrySignal() || dryDelaySamples > 0)
+            storeDrySignal(buffer);
+
         auto preRMS = computeRMSLevel(buffer);
 
         auto block = juce::dsp::AudioBlock<float>(buffer);
@@ -298,20 +1481,53 @@ struct CompressorBand
 
         auto convertToDb = [](auto input)
         {
-            return juce::Decibels::gainToDecibels(input);
+            return juce::Decibels::gainToDecibels(input, -48.f);
         };
-        rmsInputLevelDb.store(convertToDb(preRMS));
-        rmsOutputLevelDb.store(convertToDb(postRMS));
+        meterValues.inputRmsDb = convertToDb(preRMS);
+        meterValues.outputRmsDb = convertToDb(postRMS);
+        meterValues.outputPeakDb = convertToDb(buffer.getMagnitude(0, buffer.getNumSamples()));
+        meterValues.gainReductionMaxDb = compressor.getGainReductionMaxDb();
+        meterValues.gainReductionMeanDb = compressor.getGainReductionMeanDb();
+        meterValues.gainReductionMinDb = compressor.getGainReductionMinDb();
     }
 
-    float getRMSOutputLevelDb() const { return rmsOutputLevelDb; }
-    float getRMSInputLevelDb() const { return rmsInputLevelDb; }
+    bool needsDrySignal() const { return wetGain.start < 1.f || wetGain.end < 1.f; }
+    bool needsMakeupGain() const { return makeupGain.start != 1.f || makeupGain.end != 1.f; }
+    const GainRamp& getWetGainRamp() const { return wetGain; }
+    const GainRamp& getMakeupGainRamp() const { return makeupGain; }
+    const juce::AudioBuffer<float>& getDryBuffer() const { return dryBuffer; }
+
+    //tylko wątek audio - do GUI trafia przez MeterSnapshot
+    const BandMeterValues& getMeterValues() const { return meterValues; }
 
 private:
-    juce::dsp::Compressor<float> compressor;
-    
-    std::atomic<float> rmsInputLevelDb{ -48.f };
-    std::atomic<float> rmsOutputLevelDb{ -48.f };
+    CompressorKernel compressor;
+
+    static constexpr double maxDryDelaySeconds = 0.05;
+    juce::AudioBuffer<float> dryBuffer;
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> dryDelay;
+    int dryDelaySamples = 0;
+    GainRamp wetGain;
+    GainRamp makeupGain;
+
+    BandMeterValues meterValues;
+
+    void storeDrySignal(const juce::AudioBuffer<float>& buffer)
+    {
+        auto numChannels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+        auto numSamples = buffer.getNumSamples();
+        jassert(numSamples <= dryBuffer.getNumSamples());
+
+        for (int chan = 0; chan < numChannels; ++chan)
+            dryBuffer.copyFrom(chan, 0, buffer, chan, 0, numSamples);
+
+        if (dryDelaySamples > 0)
+        {
+            auto block = juce::dsp::AudioBlock<float>(dryBuffer).getSubsetChannelBlock(0, (size_t)numChannels)
+                                                                 .getSubBlock(0, (size_t)numSamples);
+            dryDelay.process(juce::dsp::ProcessContextReplacing<float>(block));
+        }
+    }
 
     template<typename T>
     float computeRMSLevel(const T& buffer)
@@ -327,6 +1543,258 @@ private:
         return rms;
     }
 };
+//limiter z wyprzedzeniem (lookahead) na sumie pasm
+//detekcja true-peak (interpolacja 4x), minimum kroczące O(1) i wygładzanie średnią ruchomą
+struct LookaheadLimiter
+{
+    juce::AudioParameterBool* enabled{ nullptr };
+    juce::AudioParameterFloat* ceiling{ nullptr };
+    juce::AudioParameterFloat* release{ nullptr };
+
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        sampleRate = spec.sampleRate;
+        numChannels = static_cast<int>(spec.numChannels);
+
+        lookaheadSamples = juce::jmax(1, juce::roundToInt(sampleRate * lookaheadSeconds));
+        const auto windowSize = lookaheadSamples + 1;
+
+        //wszystkie bufory alokowane tutaj, processBlock nic nie alokuje
+        delayLength = lookaheadSamples + truePeakDelay;
+        delayBuffer.setSize(numChannels, delayLength, false, true, false);
+        history.setSize(numChannels, 2 * numInterpolationTaps, false, true, false);
+
+        //+2: chwilowo w kolejce może być windowSize + 1 elementów
+        holdValues.assign(static_cast<size_t>(windowSize + 2), 1.f);
+        holdIndices.assign(static_cast<size_t>(windowSize + 2), 0);
+        smoothingWindow.assign(static_cast<size_t>(windowSize), 1.f);
+
+        computeInterpolationTaps();
+        reset();
+    }
+
+    void reset()
+    {
+        delayBuffer.clear();
+        history.clear();
+        delayPos = 0;
+        historyPos = 0;
+
+        holdHead = holdTail = 0;
+        sampleIndex = 0;
+
+        resetSmoothing();
+        releasedGain = 1.f;
+        bypassRampSamples = 0;
+    }
+
+    //latencja stała niezależnie od włączenia limitera - host nie musi kompensować na nowo
+    int getLatencySamples() const { return lookaheadSamples + truePeakDelay; }
+
+    void process(juce::AudioBuffer<float>& buffer)
+    {
+        const auto isEnabled = enabled->get();
+        const auto windowSize = lookaheadSamples + 1;
+        if (isEnabled && !wasEnabled)
+        {
+            resetDetector();
+            bypassRampSamples = 0;
+        }
+        else if (!isEnabled && wasEnabled)
+        {
+            bypassRampSamples = windowSize;
+        }
+        wasEnabled = isEnabled;
+
+        const auto ceilingGain = juce::Decibels::decibelsToGain(ceiling->get());
+        const auto releaseCoeff = static_cast<float>(std::exp(-1.0 / (release->get() * 0.001 * sampleRate)));
+
+        const auto numSamples = buffer.getNumSamples();
+        const auto nc = juce::jmin(numChannels, buffer.getNumChannels());
+        const auto invWindowSize = 1.0 / static_cast<double>(windowSize);
+        auto* const* channels = buffer.getArrayOfWritePointers();
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            auto gain = 1.f;
+
+            if (isEnabled)
+            {
+                auto peak = 0.f;
+                for (int ch = 0; ch < nc; ++ch)
+                    peak = juce::jmax(peak, pushAndGetTruePeak(ch, channels[ch][n]));
+                historyPos = (historyPos + 1) % numInterpolationTaps;
+
+                auto requiredGain = peak > ceilingGain ? ceilingGain / peak : 1.f;
+
+                //minimum kroczące z ostatnich windowSize próbek (kolejka monotoniczna)
+                auto held = pushAndGetWindowMinimum(requiredGain, windowSize);
+
+                //spadek natychmiastowy, powrót z czasem release
+                releasedGain = held < releasedGain ? held : held + releaseCoeff * (releasedGain - held);
+
+                //średnia ruchoma po oknie lookahead - wzmocnienie zdąży zejść przed szczytem
+                pushSmoothing(releasedGain, windowSize);
+                gain = static_cast<float>(smoothingSum * invWindowSize);
+            }
+            else if (bypassRampSamples > 0)
+            {
+                //wyłączenie w trakcie ograniczania: średnia ruchoma dochodzi do 1 w ciągu okna lookahead, bez skoku
+                releasedGain = 1.f;
+                pushSmoothing(releasedGain, windowSize);
+                gain = static_cast<float>(smoothingSum * invWindowSize);
+
+                if (--bypassRampSamples == 0)
+                    resetSmoothing();
+            }
+
+            for (int ch = 0; ch < nc; ++ch)
+            {
+                auto* delayed = delayBuffer.getWritePointer(ch);
+                auto out = delayed[delayPos];
+                delayed[delayPos] = channels[ch][n];
+                channels[ch][n] = out * gain;
+            }
+
+            if (++delayPos == delayLength)
+                delayPos = 0;
+        }
+    }
+
+private:
+    static constexpr double lookaheadSeconds = 0.0015;
+    static constexpr int oversamplingFactor = 4;
+    static constexpr int numInterpolationTaps = 12;
+    //interpolacja dotyczy odcinka między próbkami n-6 i n-5 (12 współczynników na fazę jak w BS.1770)
+    static constexpr int truePeakDelay = numInterpolationTaps / 2;
+
+    double sampleRate = 44100.0;
+    int numChannels = 2;
+    int lookaheadSamples = 1;
+    bool wasEnabled = false;
+    int bypassRampSamples = 0;
+
+    //opóźnienie sygnału audio = lookahead + opóźnienie detekcji true-peak
+    juce::AudioBuffer<float> delayBuffer;
+    int delayLength = 1;
+    int delayPos = 0;
+
+    //historia wejścia do interpolacji, zapisywana podwójnie żeby odczyt był ciągły
+    juce::AudioBuffer<float> history;
+    int historyPos = 0;
+    std::array<std::array<float, numInterpolationTaps>, oversamplingFactor - 1> interpolationTaps;
+
+    //kolejka monotoniczna minimum (bufor cykliczny, bez alokacji)
+    std::vector<float> holdValues;
+    std::vector<juce::int64> holdIndices;
+    int holdHead = 0, holdTail = 0;
+    juce::int64 sampleIndex = 0;
+
+    std::vector<float> smoothingWindow;
+    int smoothingPos = 0;
+    double smoothingSum = 1.0;
+    float releasedGain = 1.f;
+
+    //wygładzanie zostaje - po włączeniu w trakcie powrotu do 1 wzmocnienie nie skacze
+    void resetDetector()
+    {
+        history.clear();
+        historyPos = 0;
+        holdHead = holdTail = 0;
+    }
+
+    void resetSmoothing()
+    {
+        std::fill(smoothingWindow.begin(), smoothingWindow.end(), 1.f);
+        smoothingPos = 0;
+        smoothingSum = static_cast<double>(smoothingWindow.size());
+    }
+
+    void pushSmoothing(float value, int windowSize)
+    {
+        smoothingSum += value - smoothingWindow[(size_t)smoothingPos];
+        smoothingWindow[(size_t)smoothingPos] = value;
+        if (++smoothingPos == windowSize)
+            smoothingPos = 0;
+    }
+
+    void computeInterpolationTaps()
+    {
+        using namespace juce;
+        for (int phase = 1; phase < oversamplingFactor; ++phase)
+        {
+            auto& taps = interpolationTaps[(size_t)(phase - 1)];
+            auto sum = 0.f;
+            for (int k = 0; k < numInterpolationTaps; ++k)
+            {
+                //odległość próbki x[n-k] od interpolowanego punktu x[n-truePeakDelay+phase/4]
+                auto t = static_cast<float>(truePeakDelay - k) - static_cast<float>(phase) / oversamplingFactor;
+                auto sinc = std::abs(t) < 1.0e-6f ? 1.f : std::sin(MathConstants<float>::pi * t) / (MathConstants<float>::pi * t);
+                auto window = 0.5f + 0.5f * std::cos(MathConstants<float>::pi * t / (truePeakDelay + 0.5f));
+                taps[(size_t)k] = sinc * window;
+                sum += taps[(size_t)k];
+            }
+            for (auto& tap : taps)
+                tap /= sum;
+        }
+    }
+
+    float pushAndGetTruePeak(int channel, float sample)
+    {
+        auto* h = history.getWritePointer(channel);
+        h[historyPos] = sample;
+        h[historyPos + numInterpolationTaps] = sample;
+
+        //h[start + k] = x[n - (numInterpolationTaps - 1) + k]
+        const auto* x = h + historyPos + 1;
+
+        auto peak = std::abs(x[numInterpolationTaps - 1 - truePeakDelay]);
+        for (const auto& taps : interpolationTaps)
+        {
+            auto y = 0.f;
+            for (int k = 0; k < numInterpolationTaps; ++k)
+                y += taps[(size_t)k] * x[numInterpolationTaps - 1 - k];
+            peak = juce::jmax(peak, std::abs(y));
+        }
+        return peak;
+    }
+
+    float pushAndGetWindowMinimum(float value, int windowSize)
+    {
+        const auto capacity = static_cast<int>(holdValues.size());
+        auto prev = [capacity](int i) { return i == 0 ? capacity - 1 : i - 1; };
+
+        while (holdHead != holdTail && holdValues[(size_t)prev(holdTail)] >= value)
+            holdTail = prev(holdTail);
+
+        holdValues[(size_t)holdTail] = value;
+        holdIndices[(size_t)holdTail] = sampleIndex;
+        holdTail = (holdTail + 1) % capacity;
+
+        if (holdIndices[(size_t)holdHead] <= sampleIndex - windowSize)
+            holdHead = (holdHead + 1) % capacity;
+
+        ++sampleIndex;
+        return holdValues[(size_t)holdHead];
+    }
+};
+//stan mierników publikowany raz na blok - spójny dla wszystkich pasm
+struct MeterSnapshot
+{
+    std::array<BandMeterValues, 4> bands;
+    float inputRmsDb = -48.f;
+    float outputRmsDb = -48.f;
+};
+
+//zakres redukcji wzmocnienia pasm w jednym bloku - do historii w edytorze
+//minDb = największa redukcja, maxDb = najmniejsza
+struct GainReductionFrame
+{
+    std::array<float, 4> minDb{};
+    std::array<float, 4> maxDb{};
+    float durationSeconds = 0.f;
+};
+
 //==============================================================================
 /**
 */
@@ -376,8 +1844,18 @@ public:
     APVTS apvts{ *this, nullptr, "Parameters", createParameterLayout() };
 
     using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo{ Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo{ Channel::Right };
+	using AnalyzerFifo = SingleChannelSampleFifo<BlockType>;
+
+	//odbiorcy FIFO analizatora (wątek GUI) - bez odbiorców wątek audio nie zasila FIFO danego punktu odczytu,
+	//a ich pamięć jest zwalniana z opóźnieniem, gdy wątek audio potwierdzi bezczynność
+	//zasilanych jest najwyżej maxActiveAnalyzerTaps punktów naraz - false, gdy limit jest zajęty
+	static constexpr int maxActiveAnalyzerTaps = 2;
+	//sprawdzenie przed zwolnieniem innego punktu odczytu - releasedTap liczony jako wolny, jeśli ma tylko tego odbiorcę
+	bool canAddAnalyzerConsumer(AnalyzerTap tap) const;
+	bool canAddAnalyzerConsumer(AnalyzerTap tap, AnalyzerTap releasedTap) const;
+	bool addAnalyzerConsumer(AnalyzerTap tap);
+	void removeAnalyzerConsumer(AnalyzerTap tap);
+	AnalyzerFifo& getAnalyzerFifo(AnalyzerTap tap, Channel channel);
 	/*
 	juce::dsp::Compressor<float> compressor;
 	juce::AudioParameterFloat* attack{ nullptr };
@@ -393,12 +1871,28 @@ public:
 	CompressorBand& highMidComp = compressors[2];
 	CompressorBand& highComp = compressors[3];
 
+	//mierniki dla edytora - zapis raz na blok, odczyt bez alokacji
+	TripleBuffer<MeterSnapshot> meterSnapshots;
+
+	//historia redukcji - kolejka bez blokad, ~1 s zapasu przy blokach 64 próbek / 48 kHz
+	Fifo<GainReductionFrame, 1024> gainReductionHistory;
+
 private:
-	//filtry Linkwitza-Rileya
-	using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-	
-	Filter LP1, LP2, LP3;
-	Filter HP1, HP2, HP3;
+	//filtry Linkwitza-Rileya - 12/24/48 dB/okt, każde nachylenie to osobna instancja szablonu
+	CrossoverBandSplitter<2> crossoverLR2;
+	CrossoverBandSplitter<4> crossoverLR4;
+	CrossoverBandSplitter<8> crossoverLR8;
+	juce::AudioParameterChoice* crossoverSlopeParameter{ nullptr };
+
+	//zmiana nachylenia: nowy podział narasta, a stary wygasa przez crossoverFadeSeconds
+	//(kolejna zmiana czeka na koniec przejścia); bufory starego podziału z prepareToPlay
+	Parameters::CrossoverSlope crossoverSlope = Parameters::CrossoverSlope::db24PerOct;
+	Parameters::CrossoverSlope fadingCrossoverSlope = Parameters::CrossoverSlope::db24PerOct;
+	bool crossoverNeedsReset = true;
+	int crossoverFadeLength = 1;
+	int crossoverFadeRemaining = 0;
+	std::array<juce::AudioBuffer<float>, 4> fadingFilterBuffers;
+	static constexpr double crossoverFadeSeconds = 0.02;
 
 	juce::AudioParameterFloat* lowLowMidCrossover{ nullptr };
 	juce::AudioParameterFloat* lowMidHighMidCrossover{ nullptr };
@@ -410,11 +1904,42 @@ private:
 	juce::AudioParameterFloat* inputGainParameter{ nullptr };
 	juce::AudioParameterFloat* outputGainParameter{ nullptr };
 
+	//miks równoległy (dry/wet) dla wszystkich pasm
+	juce::AudioParameterFloat* globalMixParameter{ nullptr };
+
+	//limiter po wzmocnieniu wyjściowym
+	LookaheadLimiter limiter;
+
+	//zasilanie analizatora tylko przy podłączonym odbiorcy
+	struct AnalyzerFifoReleaser : juce::Timer
+	{
+		explicit AnalyzerFifoReleaser(Projekt_zespoowy_2022AudioProcessor& p) : processor(p) {}
+		void timerCallback() override;
+		Projekt_zespoowy_2022AudioProcessor& processor;
+	};
+
+	struct AnalyzerTapFifos
+	{
+		AnalyzerFifo left{ Channel::Left }, right{ Channel::Right };
+		std::atomic<int> consumers{ 0 };
+		std::atomic<bool> idle{ true };	//potwierdzenie wątku audio: blok bez zasilania FIFO
+		bool allocated = false;			//wątek GUI / prepareToPlay
+	};
+
+	//wątek audio: kopia całego bloku do pierścieni punktu odczytu (memcpy), o ile ktoś go czyta
+	void feedAnalyzerTap(AnalyzerTap tap, const BlockType& block);
+	//punkt odczytu pasma: wkład pasma do wyjścia (makeup i miks dry/wet) liczony przy kopiowaniu do pierścieni
+	void feedAnalyzerBandTap(size_t band);
+	void prepareAnalyzerFifos(AnalyzerTapFifos& tap);
+	void releaseAnalyzerFifos(AnalyzerTapFifos& tap);
+	void releaseAnalyzerFifosIfIdle();
+	int getNumActiveAnalyzerTaps() const;
 
+	std::array<AnalyzerTapFifos, (size_t)AnalyzerTap::numTaps> analyzerTaps;
+	int analyzerBlockSize = 0;
+	AnalyzerFifoReleaser analyzerFifoReleaser{ *this };
+	static constexpr int analyzerReleaseDelayMs = 2000;
 
-	//testowanie odwróconym allpass
-	//Filter invAP;
-	//juce::AudioBuffer<float> invAPBuffer;
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Projekt_zespoowy_2022AudioProcessor)
 };
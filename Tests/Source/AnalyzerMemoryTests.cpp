@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    Pomiar pamięci analizatora dla 100 instancji: rzeczywiste alokacje
+    (zastąpione globalne operator new/delete), a nie szacunek z rozmiarów buforów.
+    Uruchamianie: CompressMeTests Memory
+
+  ==============================================================================
+*/
+
+#include "../../Source/PluginEditor.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+//==============================================================================
+//licznik żywych bajtów - rozmiar zapisany przed blokiem, żeby delete bez rozmiaru też był liczony
+namespace
+{
+    std::atomic<juce::int64> liveBytes{ 0 };
+    constexpr size_t headerSize = alignof(std::max_align_t);
+
+    void* countedAllocate(size_t size)
+    {
+        auto* block = static_cast<char*>(std::malloc(size + headerSize));
+        if (block == nullptr)
+            throw std::bad_alloc();
+
+        *reinterpret_cast<size_t*>(block) = size;
+        liveBytes.fetch_add((juce::int64)size);
+        return block + headerSize;
+    }
+
+    void countedFree(void* p) noexcept
+    {
+        if (p == nullptr)
+            return;
+
+        auto* block = static_cast<char*>(p) - headerSize;
+        liveBytes.fetch_sub((juce::int64)*reinterpret_cast<size_t*>(block));
+        std::free(block);
+    }
+}
+
+void* operator new(size_t size) { return countedAllocate(size); }
+void* operator new[](size_t size) { return countedAllocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { try { return countedAllocate(size); } catch (...) { return nullptr; } }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { try { return countedAllocate(size); } catch (...) { return nullptr; } }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+
+//==============================================================================
+//układ sprzed wspólnej pamięci podręcznej, odtworzony 1:1: na edytor dwa producenty (kanał L i P), każdy z własną
+//juce::dsp::FFT i oknem, Fifo 30 wektorów FFT (2N), Fifo 30 ścieżek i buforem mono
+struct BaselinePathProducer
+{
+    BaselinePathProducer()
+    {
+        forwardFFT = std::make_unique<juce::dsp::FFT>(order);
+        window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
+
+        fftData.resize(fftSize * 2, 0);
+        fftDataFifo.prepare(fftData.size());
+        monoBuffer.setSize(1, fftSize);
+    }
+
+    //jedna ramka: FFT do Fifo, odczyt, ścieżka do Fifo, odczyt najnowszej - jak PathProducer::process
+    void process(juce::Rectangle<float> fftBounds)
+    {
+        std::copy(monoBuffer.getReadPointer(0), monoBuffer.getReadPointer(0) + fftSize, fftData.begin());
+        window->multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+        forwardFFT->performFrequencyOnlyForwardTransform(fftData.data());
+        fftDataFifo.push(fftData);
+
+        std::vector<float> renderData;
+        if (!fftDataFifo.pull(renderData))
+            return;
+
+        juce::Path p;
+        p.preallocateSpace(3 * (int)fftBounds.getWidth());
+        p.startNewSubPath(0, fftBounds.getBottom());
+        for (int binNum = 1; binNum < fftSize / 2; binNum += 4)
+            p.lineTo((float)binNum, juce::jmap(renderData[(size_t)binNum], -48.f, 12.f, fftBounds.getBottom(), fftBounds.getY()));
+
+        pathFifo.push(p);
+        pathFifo.pull(latestPath);
+    }
+
+    static constexpr FFTOrder order = FFTOrder::order2048;
+    static constexpr int fftSize = 1 << order;
+
+    std::unique_ptr<juce::dsp::FFT> forwardFFT;
+    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+    std::vector<float> fftData;
+    Fifo<std::vector<float>> fftDataFifo;
+    Fifo<juce::Path> pathFifo;
+    juce::AudioBuffer<float> monoBuffer;
+    juce::Path latestPath;
+};
+
+//==============================================================================
+class AnalyzerMemoryTest : public juce::UnitTest
+{
+public:
+    AnalyzerMemoryTest() : juce::UnitTest("Analyzer memory", "Memory") {}
+
+    void runTest() override
+    {
+        //pamięć podręczna żyje przez cały test - jak przy otwartym edytorze w procesie
+        juce::SharedResourcePointer<FFTPlanCache> cache;
+
+        beginTest("100 instances, before: per-producer FFT, window and 30-slot FIFOs");
+        const auto before = measureBaseline();
+
+        beginTest("100 instances, after: shared plans and windows, working buffers only");
+        const auto after = measureCurrent();
+
+        logMessage("per instance: before " + formatBytes(before / numInstances)
+                   + ", after " + formatBytes(after / numInstances));
+        expectLessThan(after / numInstances, maxBytesPerInstance, "analyzer working memory per instance over budget");
+    }
+
+private:
+    static constexpr int numInstances = 100;
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+    static constexpr int baselineFrames = 32;   //każdy slot obu Fifo zapełniony co najmniej raz
+
+    //budżet na edytor z dwoma aktywnymi punktami odczytu (rząd 2048, niskie pasmo, ścieżki 600 px)
+    static constexpr juce::int64 maxBytesPerInstance = 512 * 1024;
+
+    static juce::Rectangle<float> getBounds() { return { 0.f, 0.f, 600.f, 200.f }; }
+
+    //stan analizy jednego edytora: po PathProducer na każdy aktywny punkt odczytu
+    //FIFO należą do procesora - przygotowywane przed pomiarem i poza nim
+    struct Instance
+    {
+        using ChannelFifo = PathProducer::ChannelFifo;
+
+        Instance()
+        {
+            for (auto& fifo : fifos)
+                fifo.prepare(blockSize);
+        }
+
+        void createProducers()
+        {
+            for (size_t i = 0; i < producers.size(); ++i)
+                producers[i] = std::make_unique<PathProducer>(fifos[2 * i], fifos[2 * i + 1]);
+        }
+
+        std::array<ChannelFifo, 2 * Projekt_zespoowy_2022AudioProcessor::maxActiveAnalyzerTaps> fifos
+        {
+            ChannelFifo(Channel::Left), ChannelFifo(Channel::Right),
+            ChannelFifo(Channel::Left), ChannelFifo(Channel::Right)
+        };
+        std::array<std::unique_ptr<PathProducer>, Projekt_zespoowy_2022AudioProcessor::maxActiveAnalyzerTaps> producers;
+    };
+
+    juce::int64 measureBaseline()
+    {
+        std::vector<std::unique_ptr<BaselinePathProducer>> producers;
+        producers.reserve(numInstances * 2);
+
+        const auto before = liveBytes.load();
+
+        for (auto i = 0; i < numInstances * 2; ++i)
+        {
+            producers.push_back(std::make_unique<BaselinePathProducer>());
+            for (auto frame = 0; frame < baselineFrames; ++frame)
+                producers.back()->process(getBounds());
+        }
+
+        const auto used = liveBytes.load() - before;
+        logMessage(juce::String(numInstances) + " instances: " + formatBytes(used));
+        return used;
+    }
+
+    juce::int64 measureCurrent()
+    {
+        std::vector<std::unique_ptr<Instance>> instances;
+        instances.reserve(numInstances);
+
+        for (auto i = 0; i < numInstances; ++i)
+            instances.push_back(std::make_unique<Instance>());
+
+        juce::AudioBuffer<float> block(2, blockSize);
+        block.clear();
+
+        //bez pamięci samych FIFO (procesor), bloku wejściowego i list wskaźników testu
+        const auto before = liveBytes.load();
+
+        //stan ustalony: pierwsza ramka pełnego i niskiego pasma oraz ścieżki
+        for (auto& instance : instances)
+        {
+            instance->createProducers();
+
+            for (auto& producer : instance->producers)
+            {
+                producer->setMultiResolution(true);
+                producer->process(getBounds(), sampleRate);
+            }
+
+            for (auto blocks = 0; blocks < 16; ++blocks)
+            {
+                for (auto& fifo : instance->fifos)
+                    fifo.update(block);
+
+                for (auto& producer : instance->producers)
+                    producer->process(getBounds(), sampleRate);
+            }
+        }
+
+        const auto used = liveBytes.load() - before;
+        logMessage(juce::String(numInstances) + " instances: " + formatBytes(used));
+        return used;
+    }
+
+    static juce::String formatBytes(juce::int64 bytes)
+    {
+        return juce::String(double(bytes) / 1024.0, 1) + " KiB";
+    }
+};
+
+static AnalyzerMemoryTest analyzerMemoryTest;
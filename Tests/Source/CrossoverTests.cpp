@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    Testy podziału na pasma: suma LOW + LM + HM + HIGH musi być równa
+    kaskadzie filtrów wszechprzepustowych na tych samych częstotliwościach.
+
+  ==============================================================================
+*/
+
+#include "../../Source/PluginProcessor.h"
+
+#include <random>
+
+class CrossoverNullTest : public juce::UnitTest
+{
+public:
+    CrossoverNullTest() : juce::UnitTest("Crossover null test", "DSP") {}
+
+    void runTest() override
+    {
+        runForOrder<2>("LR2 (12 dB/oct)");
+        runForOrder<4>("LR4 (24 dB/oct)");
+        runForOrder<8>("LR8 (48 dB/oct)");
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+    static constexpr int numBlocks = 40;
+    static constexpr int numChannels = 2;
+
+    //reszta po odjęciu referencji względem szczytu referencji
+    static constexpr float maxResidualDb = -100.f;
+
+    struct Cutoffs
+    {
+        float lowLowMid, lowMidHighMid, highMidHigh;
+    };
+
+    //typowe ustawienie, skrajne częstotliwości i blisko siebie położone podziały
+    static constexpr std::array<Cutoffs, 4> cutoffSettings
+    {{
+        { 120.f, 1000.f, 6000.f },
+        { 20.f, 200.f, 2000.f },
+        { 500.f, 5000.f, 20000.f },
+        { 900.f, 1000.f, 1100.f }
+    }};
+
+    template<int Order>
+    void runForOrder(const juce::String& name)
+    {
+        for (const auto& cutoffs : cutoffSettings)
+        {
+            beginTest(name + " " + juce::String(cutoffs.lowLowMid) + " / " + juce::String(cutoffs.lowMidHighMid)
+                      + " / " + juce::String(cutoffs.highMidHigh) + " Hz");
+
+            auto residualDb = measureResidual<Order>(cutoffs);
+            expectLessThan(residualDb, maxResidualDb, "band sum differs from the allpass cascade by " + juce::String(residualDb) + " dB");
+        }
+    }
+
+    template<int Order>
+    float measureResidual(const Cutoffs& cutoffs)
+    {
+        juce::dsp::ProcessSpec spec;
+        spec.sampleRate = sampleRate;
+        spec.maximumBlockSize = blockSize;
+        spec.numChannels = numChannels;
+
+        CrossoverBandSplitter<Order> splitter;
+        splitter.prepare(spec);
+        splitter.setCutoffFrequencies(cutoffs.lowLowMid, cutoffs.lowMidHighMid, cutoffs.highMidHigh);
+
+        //referencja: niezależna kaskada AP(f1) * AP(f2) * AP(f3)
+        std::array<LinkwitzRileyFilter<Order>, 3> allpasses;
+        const std::array<float, 3> frequencies{ cutoffs.lowLowMid, cutoffs.lowMidHighMid, cutoffs.highMidHigh };
+        for (size_t i = 0; i < allpasses.size(); ++i)
+        {
+            allpasses[i].setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+            allpasses[i].prepare(spec);
+            allpasses[i].setCutoffFrequency(frequencies[i]);
+        }
+
+        std::array<juce::AudioBuffer<float>, 4> bands;
+        for (auto& band : bands)
+            band.setSize(numChannels, blockSize);
+
+        juce::AudioBuffer<float> input(numChannels, blockSize);
+        juce::AudioBuffer<float> reference(numChannels, blockSize);
+
+        //impuls, cisza na wybrzmienie, potem szum
+        std::mt19937 random(1);
+        std::normal_distribution<float> noise(0.f, 0.3f);
+
+        auto maxResidual = 0.f;
+        auto maxReference = 0.f;
+
+        for (auto block = 0; block < numBlocks; ++block)
+        {
+            for (auto ch = 0; ch < numChannels; ++ch)
+            {
+                for (auto i = 0; i < blockSize; ++i)
+                {
+                    auto sample = block < numBlocks / 2 ? (block == 0 && i == 0 ? 1.f : 0.f) : noise(random);
+                    input.setSample(ch, i, sample);
+                }
+            }
+
+            reference.makeCopyOf(input, true);
+            auto referenceBlock = juce::dsp::AudioBlock<float>(reference);
+            for (auto& allpass : allpasses)
+                allpass.process(juce::dsp::ProcessContextReplacing<float>(referenceBlock));
+
+            splitter.process(input, bands);
+
+            for (auto ch = 0; ch < numChannels; ++ch)
+            {
+                for (auto i = 0; i < blockSize; ++i)
+                {
+                    auto sum = 0.f;
+                    for (const auto& band : bands)
+                        sum += band.getSample(ch, i);
+
+                    auto expected = reference.getSample(ch, i);
+                    maxResidual = juce::jmax(maxResidual, std::abs(sum - expected));
+                    maxReference = juce::jmax(maxReference, std::abs(expected));
+                }
+            }
+        }
+
+        return juce::Decibels::gainToDecibels(maxResidual / maxReference, -200.f);
+    }
+};
+
+static CrossoverNullTest crossoverNullTest;
@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    Porównanie własnej FFT z juce::dsp::FFT dla rzędów 9-15: czas i zgodność widma mocy
+    dwóch kanałów (FFTPlan::performStereoPowerSpectrumTransform) oraz widma zespolonego
+    sygnału rzeczywistego (FFTPlan::performRealOnlyForwardTransform).
+    Uruchamianie: CompressMeTests Benchmark (wersja Release)
+
+  ==============================================================================
+*/
+
+#include "../../Source/FFTEngine.h"
+
+#include <random>
+
+class FFTBenchmark : public juce::UnitTest
+{
+public:
+    FFTBenchmark() : juce::UnitTest("FFT engines", "Benchmark") {}
+
+    void runTest() override
+    {
+        for (auto order = (int)order512; order <= (int)order32768; ++order)
+        {
+            beginTest("order " + juce::String(order));
+
+            const FFTPlan inTree(order, FFTEngine::inTree);
+            const FFTPlan juceFFT(order, FFTEngine::juceFFT);
+
+            const auto stereoInTree = timeTransform(inTree, &Buffers::transform);
+            const auto stereoJuce = timeTransform(juceFFT, &Buffers::transform);
+            const auto stereoError = compareSpectra(inTree, juceFFT);
+
+            const auto realInTree = timeTransform(inTree, &Buffers::transformReal);
+            const auto realJuce = timeTransform(juceFFT, &Buffers::transformReal);
+            const auto realError = compareRealSpectra(inTree, juceFFT);
+
+            logMessage("order " + juce::String(order)
+                       + ": stereo power in-tree " + juce::String(stereoInTree, 1) + " us"
+                       + ", juce::dsp::FFT " + juce::String(stereoJuce, 1) + " us"
+                       + ", max relative error " + juce::String(stereoError, 9));
+            logMessage("order " + juce::String(order)
+                       + ": real forward in-tree " + juce::String(realInTree, 1) + " us"
+                       + ", juce::dsp::FFT " + juce::String(realJuce, 1) + " us"
+                       + ", max relative error " + juce::String(realError, 9));
+
+            expectLessThan(stereoError, maxRelativeError);
+            expectLessThan(realError, maxRelativeError);
+        }
+    }
+
+private:
+    //względem największego prążka widma - ten sam zakres, jaki widzi analizator
+    static constexpr double maxRelativeError = 1.0e-5;
+    static constexpr double minimumSeconds = 0.2;
+
+    struct Buffers
+    {
+        Buffers(int fftSize, unsigned int seed) :
+            size(fftSize),
+            inputLeft((size_t)fftSize), inputRight((size_t)fftSize),
+            left((size_t)fftSize * 2), right((size_t)fftSize * 2), scratch((size_t)fftSize * 2)
+        {
+            std::mt19937 random(seed);
+            std::uniform_real_distribution<float> noise(-1.f, 1.f);
+            for (auto i = 0; i < size; ++i)
+            {
+                inputLeft[(size_t)i] = noise(random);
+                inputRight[(size_t)i] = noise(random);
+            }
+        }
+
+        //transformacja jest w miejscu - każde wywołanie dostaje świeżą kopię wejścia
+        void transform(const FFTPlan& plan)
+        {
+            std::copy(inputLeft.begin(), inputLeft.end(), left.begin());
+            std::copy(inputRight.begin(), inputRight.end(), right.begin());
+            plan.performStereoPowerSpectrumTransform(left.data(), right.data(), scratch.data());
+        }
+
+        //lewy kanał, widmo zespolone tylko nieujemnych częstotliwości (size / 2 + 1 par re/im)
+        void transformReal(const FFTPlan& plan)
+        {
+            std::copy(inputLeft.begin(), inputLeft.end(), left.begin());
+            plan.performRealOnlyForwardTransform(left.data(), true);
+        }
+
+        int size;
+        std::vector<float> inputLeft, inputRight;
+        std::vector<float> left, right, scratch;
+    };
+
+    using Transform = void (Buffers::*)(const FFTPlan&);
+
+    //średni czas jednej transformacji (razem z kopią wejścia, taką samą dla obu silników)
+    static double timeTransform(const FFTPlan& plan, Transform transform)
+    {
+        Buffers buffers(plan.getSize(), 1);
+
+        auto iterations = 0;
+        const auto start = juce::Time::getHighResolutionTicks();
+        auto elapsed = 0.0;
+
+        do
+        {
+            for (auto i = 0; i < 16; ++i)
+                (buffers.*transform)(plan);
+
+            iterations += 16;
+            elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        } while (elapsed < minimumSeconds);
+
+        return elapsed * 1.0e6 / iterations;
+    }
+
+    static double compareSpectra(const FFTPlan& a, const FFTPlan& b)
+    {
+        const auto size = a.getSize();
+        Buffers first(size, 2), second(size, 2);
+        first.transform(a);
+        second.transform(b);
+
+        //moc -> amplituda, żeby błąd był liniowy w sygnale
+        auto maxDifference = 0.0;
+        auto maxMagnitude = 0.0;
+        for (auto k = 0; k <= size / 2; ++k)
+        {
+            for (const auto& [x, y] : { std::make_pair(first.left[(size_t)k], second.left[(size_t)k]),
+                                        std::make_pair(first.right[(size_t)k], second.right[(size_t)k]) })
+            {
+                const auto magnitudeA = std::sqrt((double)x);
+                const auto magnitudeB = std::sqrt((double)y);
+                maxDifference = juce::jmax(maxDifference, std::abs(magnitudeA - magnitudeB));
+                maxMagnitude = juce::jmax(maxMagnitude, magnitudeB);
+            }
+        }
+
+        return maxMagnitude > 0.0 ? maxDifference / maxMagnitude : 0.0;
+    }
+
+    static double compareRealSpectra(const FFTPlan& a, const FFTPlan& b)
+    {
+        const auto size = a.getSize();
+        Buffers first(size, 3), second(size, 3);
+        first.transformReal(a);
+        second.transformReal(b);
+
+        auto maxDifference = 0.0;
+        auto maxMagnitude = 0.0;
+        for (auto k = 0; k <= size / 2; ++k)
+        {
+            const std::complex<double> binA(first.left[(size_t)(2 * k)], first.left[(size_t)(2 * k + 1)]);
+            const std::complex<double> binB(second.left[(size_t)(2 * k)], second.left[(size_t)(2 * k + 1)]);
+            maxDifference = juce::jmax(maxDifference, std::abs(binA - binB));
+            maxMagnitude = juce::jmax(maxMagnitude, std::abs(binB));
+        }
+
+        return maxMagnitude > 0.0 ? maxDifference / maxMagnitude : 0.0;
+    }
+};
+
+static FFTBenchmark fftBenchmark;
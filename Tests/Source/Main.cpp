@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    Uruchamianie testów: CompressMeTests [kategoria]
+    Bez argumentu uruchamiana jest kategoria "DSP"; pomiary: "Memory", "Benchmark".
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+int main(int argc, char* argv[])
+{
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory(argc > 1 ? juce::String(argv[1]) : juce::String("DSP"));
+
+    auto failures = 0;
+    for (auto i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult(i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}